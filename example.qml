@@ -83,6 +83,8 @@ Item {
         id: scanner
         //enabledFormats: BarcodeScanner.BarCodeFormat_2D | BarcodeScanner.BarCodeFormat_1D
         enabledFormats: BarcodeScanner.BarCodeFormat_1D
+        // Or pick single symbologies, this overrides enabledFormats
+        //enabledDecoders: BarcodeScanner.DecoderFormat_EAN_13 | BarcodeScanner.DecoderFormat_Aztec
         rotate: camera.orientation!=0 ? true : false;
         onTagFound: {
             console.debug("TAG: "+tag);
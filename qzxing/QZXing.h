@@ -34,8 +34,10 @@ class
 
     Q_OBJECT
     Q_ENUMS(DecoderFormat)
+    Q_ENUMS(BinarizerType)
     Q_PROPERTY(int processingTime READ getProcessTimeOfLastDecoding)
     Q_PROPERTY(uint enabledDecoders READ getEnabledFormats WRITE setDecoder NOTIFY enabledFormatsChanged)
+    Q_PROPERTY(BinarizerType binarizer READ getBinarizer WRITE setBinarizer NOTIFY binarizerChanged)
 
 public:
     /*
@@ -63,6 +65,17 @@ public:
     } ;
     typedef unsigned int DecoderFormatType;
 
+    /*
+     * Thresholding used to turn the image into black and white modules.
+     */
+    enum BinarizerType {
+        Binarizer_Hybrid = 0,
+        Binarizer_AdaptiveThreshold,
+        Binarizer_GlobalHistogram,
+        Binarizer_Auto,
+        Binarizer_Sauvola
+    };
+
     QZXing(QObject *parent = NULL);
     ~QZXing();
 
@@ -146,17 +159,32 @@ public slots:
       */
     void setDecoder(const uint &hint);
 
+    /**
+      * Get the binarizer used by the decoding functions.
+      */
+    BinarizerType getBinarizer() const;
+    /**
+      * Set the binarizer used by the decoding functions.
+      * Binarizer_AdaptiveThreshold copes better with uneven lighting at a small extra cost.
+      * Binarizer_Sauvola also weighs the local contrast, which helps with faint or blurred codes.
+      * Binarizer_Auto uses the cheap Binarizer_GlobalHistogram for evenly lit images
+      * and Binarizer_Hybrid for the rest.
+      */
+    void setBinarizer(BinarizerType binarizer);
+
 signals:
     void decodingStarted();
     void decodingFinished(bool succeeded);
     void tagFound(QString tag);
     void enabledFormatsChanged();
+    void binarizerChanged();
     void tagFoundAdvanced(QString tag, QString format, QString charSet);
     void error(QString msg);
 
 private:
     zxing::MultiFormatReader *decoder;
     DecoderFormatType enabledDecoders;
+    BinarizerType binarizer_;
     ImageHandler *imageHandler;
     int processingTime;
     QString foundedFmt;
@@ -3,6 +3,8 @@ QT       += core gui widgets
 greaterThan(QT_VERSION, 4.7): lessThan(QT_VERSION, 5.0): QT += declarative
 greaterThan(QT_MAJOR_VERSION, 4): QT += quick
 
+CONFIG += c++11
+
 DEFINES += QZXING_LIBRARY \
         ZXING_ICONV_CONST \
         DISABLE_LIBRARY_FEATURES
@@ -42,12 +44,14 @@ HEADERS += $$PWD/QZXing_global.h \
     $$PWD/zxing/zxing/common/PerspectiveTransform.h \
     $$PWD/zxing/zxing/common/IllegalArgumentException.h \
     $$PWD/zxing/zxing/common/HybridBinarizer.h \
+    $$PWD/zxing/zxing/common/AdaptiveThresholdBinarizer.h \
     $$PWD/zxing/zxing/common/GridSampler.h \
     $$PWD/zxing/zxing/common/GreyscaleRotatedLuminanceSource.h \
     $$PWD/zxing/zxing/common/GreyscaleLuminanceSource.h \
     $$PWD/zxing/zxing/common/GlobalHistogramBinarizer.h \
     $$PWD/zxing/zxing/common/DetectorResult.h \
     $$PWD/zxing/zxing/common/DecoderResult.h \
+    $$PWD/zxing/zxing/common/DecoderResultCache.h \
     $$PWD/zxing/zxing/common/Counted.h \
     $$PWD/zxing/zxing/common/CharacterSetECI.h \
     $$PWD/zxing/zxing/common/BitSource.h \
@@ -109,20 +113,12 @@ HEADERS += $$PWD/QZXing_global.h \
     $$PWD/zxing/zxing/multi/qrcode/detector/MultiDetector.h \
     $$PWD/zxing/zxing/pdf417/decoder/ec/ErrorCorrection.h \
     $$PWD/zxing/zxing/pdf417/decoder/ec/ModulusGF.h \
-    $$PWD/zxing/zxing/pdf417/decoder/ec/ModulusPoly.h \
     $$PWD/zxing/zxing/pdf417/decoder/BitMatrixParser.h \
     $$PWD/zxing/zxing/pdf417/decoder/DecodedBitStreamParser.h \
     $$PWD/zxing/zxing/pdf417/decoder/Decoder.h \
     $$PWD/zxing/zxing/pdf417/detector/Detector.h \
     $$PWD/zxing/zxing/pdf417/detector/LinesSampler.h \
     $$PWD/zxing/zxing/pdf417/PDF417Reader.h \
-    $$PWD/zxing/bigint/NumberlikeArray.hh \
-    $$PWD/zxing/bigint/BigUnsignedInABase.hh \
-    $$PWD/zxing/bigint/BigUnsigned.hh \
-    $$PWD/zxing/bigint/BigIntegerUtils.hh \
-    $$PWD/zxing/bigint/BigIntegerLibrary.hh \
-    $$PWD/zxing/bigint/BigIntegerAlgorithms.hh \
-    $$PWD/zxing/bigint/BigInteger.hh \
     $$PWD/zxing/zxing/WriterException.h
 
 SOURCES += $$PWD/CameraImageWrapper.cpp \
@@ -150,12 +146,14 @@ SOURCES += $$PWD/CameraImageWrapper.cpp \
     $$PWD/zxing/zxing/common/PerspectiveTransform.cpp \
     $$PWD/zxing/zxing/common/IllegalArgumentException.cpp \
     $$PWD/zxing/zxing/common/HybridBinarizer.cpp \
+    $$PWD/zxing/zxing/common/AdaptiveThresholdBinarizer.cpp \
     $$PWD/zxing/zxing/common/GridSampler.cpp \
     $$PWD/zxing/zxing/common/GreyscaleRotatedLuminanceSource.cpp \
     $$PWD/zxing/zxing/common/GreyscaleLuminanceSource.cpp \
     $$PWD/zxing/zxing/common/GlobalHistogramBinarizer.cpp \
     $$PWD/zxing/zxing/common/DetectorResult.cpp \
     $$PWD/zxing/zxing/common/DecoderResult.cpp \
+    $$PWD/zxing/zxing/common/DecoderResultCache.cpp \
     $$PWD/zxing/zxing/common/CharacterSetECI.cpp \
     $$PWD/zxing/zxing/common/BitSource.cpp \
     $$PWD/zxing/zxing/common/BitMatrix.cpp \
@@ -216,18 +214,12 @@ SOURCES += $$PWD/CameraImageWrapper.cpp \
     $$PWD/zxing/zxing/qrcode/QRErrorCorrectionLevel.cpp \
     $$PWD/zxing/zxing/pdf417/decoder/ec/ErrorCorrection.cpp \
     $$PWD/zxing/zxing/pdf417/decoder/ec/ModulusGF.cpp \
-    $$PWD/zxing/zxing/pdf417/decoder/ec/ModulusPoly.cpp \
     $$PWD/zxing/zxing/pdf417/decoder/PDF417BitMatrixParser.cpp \
     $$PWD/zxing/zxing/pdf417/decoder/PDF417DecodedBitStreamParser.cpp \
     $$PWD/zxing/zxing/pdf417/decoder/PDF417Decoder.cpp \
     $$PWD/zxing/zxing/pdf417/detector/PDF417Detector.cpp \
     $$PWD/zxing/zxing/pdf417/detector/LinesSampler.cpp \
-    $$PWD/zxing/zxing/pdf417/PDF417Reader.cpp \
-    $$PWD/zxing/bigint/BigUnsignedInABase.cc \
-    $$PWD/zxing/bigint/BigUnsigned.cc \
-    $$PWD/zxing/bigint/BigIntegerUtils.cc \
-    $$PWD/zxing/bigint/BigIntegerAlgorithms.cc \
-    $$PWD/zxing/bigint/BigInteger.cc
+    $$PWD/zxing/zxing/pdf417/PDF417Reader.cpp
 
 symbian {
     TARGET.UID3 = 0xE618743C
@@ -2,6 +2,7 @@
 
 #include <zxing/common/GlobalHistogramBinarizer.h>
 #include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/AdaptiveThresholdBinarizer.h>
 #include <zxing/Binarizer.h>
 #include <zxing/BinaryBitmap.h>
 #include <zxing/MultiFormatReader.h>
@@ -21,7 +22,7 @@
 
 using namespace zxing;
 
-QZXing::QZXing(QObject *parent) : QObject(parent)
+QZXing::QZXing(QObject *parent) : QObject(parent), binarizer_(Binarizer_Hybrid)
 {
     decoder = new MultiFormatReader();
 
@@ -49,7 +50,7 @@ QZXing::~QZXing()
         delete decoder;
 }
 
-QZXing::QZXing(QZXing::DecoderFormat decodeHints, QObject *parent) : QObject(parent)
+QZXing::QZXing(QZXing::DecoderFormat decodeHints, QObject *parent) : QObject(parent), binarizer_(Binarizer_Hybrid)
 {
     decoder = new MultiFormatReader();
     imageHandler = new ImageHandler();
@@ -207,13 +208,32 @@ QString QZXing::decodeImage(QImage &image, int maxWidth, int maxHeight, bool smo
             ciw = new CameraImageWrapper(image);
 
         Ref<LuminanceSource> imageRef(ciw);
-#if 1
-        HybridBinarizer *binz = new HybridBinarizer(imageRef);
-#else
-        GlobalHistogramBinarizer *binz = new GlobalHistogramBinarizer(imageRef);
-#endif
+        BinarizerType binarizer = binarizer_;
+        if (binarizer == Binarizer_Auto)
+            binarizer = GlobalHistogramBinarizer::hasUniformLighting(imageRef) ? Binarizer_GlobalHistogram : Binarizer_Hybrid;
+
+        Ref<Binarizer> bz;
+        switch (binarizer) {
+        case Binarizer_AdaptiveThreshold:
+            bz = new AdaptiveThresholdBinarizer(imageRef);
+            break;
+        case Binarizer_Sauvola:
+            bz = new AdaptiveThresholdBinarizer(imageRef, AdaptiveThresholdBinarizer::SAUVOLA);
+            break;
+        case Binarizer_GlobalHistogram:
+            bz = new GlobalHistogramBinarizer(imageRef);
+            break;
+        default: {
+            HybridBinarizer *binz = new HybridBinarizer(imageRef);
+
+            // Share the local thresholds between 1D and 2D readers when both are enabled
+            const uint twoD = DecodeHints::QR_CODE_HINT | DecodeHints::DATA_MATRIX_HINT |
+                    DecodeHints::AZTEC_HINT | DecodeHints::PDF_417_HINT;
+            binz->setLocalBlackRows((enabledDecoders & twoD) && (enabledDecoders & ~twoD));
+            bz = binz;
+        }
+        }
 
-        Ref<Binarizer> bz(binz);
         BinaryBitmap *bb = new BinaryBitmap(bz);
 
         Ref<BinaryBitmap> ref(bb);
@@ -342,3 +362,18 @@ uint QZXing::getEnabledFormats() const
 {
     return enabledDecoders;
 }
+
+QZXing::BinarizerType QZXing::getBinarizer() const
+{
+    return binarizer_;
+}
+
+void QZXing::setBinarizer(BinarizerType binarizer)
+{
+    if (binarizer_ == binarizer)
+        return;
+
+    binarizer_ = binarizer;
+
+    emit binarizerChanged();
+}
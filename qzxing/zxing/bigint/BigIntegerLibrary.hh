@@ -1,8 +0,0 @@
-// This header file includes all of the library header files.
-
-#include "NumberlikeArray.hh"
-#include "BigUnsigned.hh"
-#include "BigInteger.hh"
-#include "BigIntegerAlgorithms.hh"
-#include "BigUnsignedInABase.hh"
-#include "BigIntegerUtils.hh"
@@ -26,6 +26,46 @@ using zxing::BinaryBitmap;
 // VC++
 using zxing::Binarizer;
 
+namespace {
+
+/**
+ * A window onto the black matrix of another bitmap. The parent matrix is
+ * computed once and kept by the parent bitmap, every crop only copies its
+ * own rectangle out of it, a word at a time, instead of binarizing the
+ * cropped luminance again.
+ */
+class CroppedBinarizer : public Binarizer {
+ private:
+  Ref<Binarizer> parent_;
+  Ref<BitMatrix> parentMatrix_;
+  int left_;
+  int top_;
+  Ref<BitMatrix> matrix_;
+
+ public:
+  CroppedBinarizer(Ref<Binarizer> parent, Ref<BitMatrix> parentMatrix, int left, int top, int width, int height)
+    : Binarizer(parent->getLuminanceSource()->crop(left, top, width, height)),
+      parent_(parent), parentMatrix_(parentMatrix), left_(left), top_(top) {
+  }
+
+  Ref<BitArray> getBlackRow(int y, Ref<BitArray> row) {
+    return getBlackMatrix()->getRow(y, row);
+  }
+
+  Ref<BitMatrix> getBlackMatrix() {
+    if (!matrix_) {
+      matrix_ = parentMatrix_->crop(left_, top_, getWidth(), getHeight());
+    }
+    return matrix_;
+  }
+
+  Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source) {
+    return parent_->createBinarizer(source);
+  }
+};
+
+}
+
 BinaryBitmap::BinaryBitmap(Ref<Binarizer> binarizer) : binarizer_(binarizer) {
 }
 	
@@ -37,7 +77,10 @@ Ref<BitArray> BinaryBitmap::getBlackRow(int y, Ref<BitArray> row) {
 }
 	
 Ref<BitMatrix> BinaryBitmap::getBlackMatrix() {
-  return binarizer_->getBlackMatrix();
+  if (!matrix_) {
+    matrix_ = binarizer_->getBlackMatrix();
+  }
+  return matrix_;
 }
 	
 int BinaryBitmap::getWidth() const {
@@ -58,7 +101,7 @@ bool BinaryBitmap::isCropSupported() const {
 }
 
 Ref<BinaryBitmap> BinaryBitmap::crop(int left, int top, int width, int height) {
-  return Ref<BinaryBitmap> (new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->crop(left, top, width, height))));
+  return Ref<BinaryBitmap> (new BinaryBitmap(Ref<Binarizer>(new CroppedBinarizer(binarizer_, getBlackMatrix(), left, top, width, height))));
 }
 
 bool BinaryBitmap::isRotateSupported() const {
@@ -30,12 +30,15 @@ namespace zxing {
 	class BinaryBitmap : public Counted {
 	private:
 		Ref<Binarizer> binarizer_;
+		Ref<BitMatrix> matrix_;
 		
 	public:
 		BinaryBitmap(Ref<Binarizer> binarizer);
 		virtual ~BinaryBitmap();
 		
 		Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
+		// Built on the first call and returned as is afterwards. Once built it
+		// can be read by several readers at the same time.
 		Ref<BitMatrix> getBlackMatrix();
 		
 		Ref<LuminanceSource> getLuminanceSource() const;
@@ -47,6 +50,7 @@ namespace zxing {
 		Ref<BinaryBitmap> rotateCounterClockwise();
 
 		bool isCropSupported() const;
+		// The crop is cut out of this bitmap's black matrix, which is built first
 		Ref<BinaryBitmap> crop(int left, int top, int width, int height);
 
 	};
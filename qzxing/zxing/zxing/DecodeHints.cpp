@@ -24,6 +24,7 @@
 
 using zxing::Ref;
 using zxing::ResultPointCallback;
+using zxing::DecoderResultCache;
 using zxing::DecodeHintType;
 using zxing::DecodeHints;
 
@@ -136,11 +137,22 @@ Ref<ResultPointCallback> DecodeHints::getResultPointCallback() const {
   return callback;
 }
 
+void DecodeHints::setDecoderResultCache(Ref<DecoderResultCache> const& _resultCache) {
+  resultCache = _resultCache;
+}
+
+Ref<DecoderResultCache> DecodeHints::getDecoderResultCache() const {
+  return resultCache;
+}
+
 zxing::DecodeHints zxing::operator | (DecodeHints const& l, DecodeHints const& r) {
   DecodeHints result (l);
   result.hints |= r.hints;
   if (!result.callback) {
     result.callback = r.callback;
   }
+  if (!result.resultCache) {
+    result.resultCache = r.resultCache;
+  }
   return result;
 }
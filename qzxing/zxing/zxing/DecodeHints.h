@@ -22,6 +22,7 @@
 
 #include <zxing/BarcodeFormat.h>
 #include <zxing/ResultPointCallback.h>
+#include <zxing/common/DecoderResultCache.h>
 
 namespace zxing {
 
@@ -33,6 +34,7 @@ class DecodeHints {
  private:
   DecodeHintType hints;
   Ref<ResultPointCallback> callback;
+  Ref<DecoderResultCache> resultCache;
 
  public:
   static const DecodeHintType AZTEC_HINT = 1 << BarcodeFormat::AZTEC;
@@ -77,6 +79,13 @@ class DecodeHints {
   void setResultPointCallback(Ref<ResultPointCallback> const&);
   Ref<ResultPointCallback> getResultPointCallback() const;
 
+  /**
+   * Lets the QR Code, Data Matrix and Aztec readers reuse the result of an
+   * earlier decode when they sample exactly the same modules again.
+   */
+  void setDecoderResultCache(Ref<DecoderResultCache> const&);
+  Ref<DecoderResultCache> getDecoderResultCache() const;
+
   friend DecodeHints operator | (DecodeHints const&, DecodeHints const&);
 };
 
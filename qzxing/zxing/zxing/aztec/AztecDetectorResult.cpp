@@ -52,3 +52,11 @@ int AztecDetectorResult::getNBDatablocks() {
 int AztecDetectorResult::getNBLayers() {
   return nbLayers_;
 }
+
+int AztecDetectorResult::getDimension(bool compact, int nbLayers) {
+  if (compact) {
+    return 4 * nbLayers + 11;
+  }
+  // A reference grid line every 16 modules out from the centre, on both sides
+  return 4 * nbLayers + 2 * ((2 * nbLayers + 6) / 15) + 15;
+}
@@ -40,6 +40,11 @@ class AztecDetectorResult : public DetectorResult {
   bool isCompact();
   int getNBDatablocks();
   int getNBLayers();
+
+  /**
+   * Side of a symbol in modules, reference grid included.
+   */
+  static int getDimension(bool compact, int nbLayers);
 };
 
 }
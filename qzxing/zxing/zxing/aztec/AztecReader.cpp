@@ -38,13 +38,32 @@ AztecReader::AztecReader() : decoder_() {
 }
         
 Ref<Result> AztecReader::decode(Ref<zxing::BinaryBitmap> image) {
+  return decode(image, DecodeHints());
+}
+        
+Ref<Result> AztecReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
   Detector detector(image->getBlackMatrix());
             
   Ref<AztecDetectorResult> detectorResult(detector.detect());
             
   ArrayRef< Ref<ResultPoint> > points(detectorResult->getPoints());
             
-  Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult));
+  // The layout of the grid is not implied by its size alone
+  Ref<DecoderResultCache> cache(hints.getDecoderResultCache());
+  int tag = BarcodeFormat::AZTEC
+    | (detectorResult->isCompact() ? 1 << 8 : 0)
+    | detectorResult->getNBLayers() << 9
+    | detectorResult->getNBDatablocks() << 16;
+  Ref<DecoderResult> decoderResult;
+  if (cache) {
+    decoderResult = cache->get(tag, detectorResult->getBits());
+  }
+  if (!decoderResult) {
+    decoderResult = decoder_.decode(detectorResult);
+    if (cache) {
+      cache->put(tag, detectorResult->getBits(), decoderResult);
+    }
+  }
             
   Ref<Result> result(new Result(decoderResult->getText(),
                                 decoderResult->getRawBytes(),
@@ -54,11 +73,6 @@ Ref<Result> AztecReader::decode(Ref<zxing::BinaryBitmap> image) {
   return result;
 }
         
-Ref<Result> AztecReader::decode(Ref<BinaryBitmap> image, DecodeHints) {
-  //cout << "decoding with hints not supported for aztec" << "\n" << flush;
-  return this->decode(image);
-}
-        
 AztecReader::~AztecReader() {
   // nothing
 }
@@ -20,9 +20,6 @@
  */
 
 #include <zxing/aztec/decoder/Decoder.h>
-#ifndef NO_ICONV
-#include <iconv.h>
-#endif
 #include <iostream>
 #include <zxing/FormatException.h>
 #include <zxing/common/reedsolomon/ReedSolomonDecoder.h>
@@ -30,37 +27,35 @@
 #include <zxing/common/reedsolomon/GenericGF.h>
 #include <zxing/common/IllegalArgumentException.h>
 #include <zxing/common/DecoderResult.h>
+#include <cstring>
+#include <mutex>
+#include <vector>
 
 #include <qglobal.h>
 
 using zxing::aztec::Decoder;
+using zxing::aztec::AztecDetectorResult;
 using zxing::DecoderResult;
 using zxing::String;
-using zxing::BitArray;
 using zxing::BitMatrix;
 using zxing::Ref;
+using zxing::ArrayRef;
 
 using std::string;
 
 namespace {
   void add(string& result, char character) {
 #ifndef NO_ICONV
-    char character2 = character & 0xff;
-    char s[] =  {character2};
-    char* ss = s;
-    size_t sl = sizeof(s);
-    char d[4];
-    char* ds = d;
-    size_t dl = sizeof(d);
-    iconv_t ic = iconv_open("UTF-8", "ISO-8859-1");
-#if defined(Q_OS_SYMBIAN)
-    iconv(ic, (const char**)&ss, &sl, &ds, &dl);
-#else
-    iconv(ic, (char**)&ss, &sl, &ds, &dl);
-#endif
-    iconv_close(ic);
-    d[sizeof(d)-dl] = 0;
-    result.append(d);
+    // ISO-8859-1 to UTF-8 is simple enough not to need an iconv descriptor per character
+    int value = character & 0xff;
+    if (value < 0x80) {
+      if (value != 0) {
+        result.push_back(character);
+      }
+    } else {
+      result.push_back((char)(0xC0 | (value >> 6)));
+      result.push_back((char)(0x80 | (value & 0x3F)));
+    }
 #else
     result.push_back(character);
 #endif
@@ -108,6 +103,81 @@ namespace {
   const char* DIGIT_TABLE[] = {
     "CTRL_PS", " ", "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", ",", ".", "CTRL_UL", "CTRL_US"
   };
+
+  const int MAX_COMPACT_LAYERS = 4;
+  const int MAX_LAYERS = 32;
+
+  // A module of the sampled symbol, reference grid included
+  struct Module {
+    unsigned char x;
+    unsigned char y;
+  };
+
+  /**
+   * Lists the modules of the data layers in bit order, outermost layer first.
+   * Full symbols have a reference grid line every 16 modules out from the
+   * centre; those rows and columns are stepped over.
+   */
+  void buildPlacement(bool compact, int layers, std::vector<Module>& modules) {
+    int dimension = AztecDetectorResult::getDimension(compact, layers);
+    std::vector<unsigned char> grid;
+    for (int i = 0; i < dimension; i++) {
+      if (compact || (dimension / 2 - i) % 16 != 0) {
+        grid.push_back((unsigned char)i);
+      }
+    }
+
+    // Every entry is a data module; a layer count the grid does not add up to
+    // would leave some of them unset
+    int size = (int)grid.size();
+    int nbBits = 0;
+    for (int layer = 0; layer < layers; layer++) {
+      nbBits += 8 * (size - 4 * layer) - 16;
+    }
+    if (nbBits != (compact ? NB_BITS_COMPACT[layers] : NB_BITS[layers])) {
+      throw zxing::FormatException("layer placement does not fill the symbol");
+    }
+    modules.resize(nbBits);
+    int rawbitsOffset = 0;
+    int matrixOffset = 0;
+    for (int layer = 0; layer < layers; layer++) {
+      int flip = 0;
+      for (int i = 0; i < 2 * size - 4; i++) {
+        Module& left = modules[rawbitsOffset + i];
+        left.x = grid[matrixOffset + flip];
+        left.y = grid[matrixOffset + i / 2];
+        Module& bottom = modules[rawbitsOffset + 2 * size - 4 + i];
+        bottom.x = grid[matrixOffset + i / 2];
+        bottom.y = grid[matrixOffset + size - 1 - flip];
+        flip = (flip + 1) % 2;
+      }
+
+      flip = 0;
+      for (int i = 2 * size + 1; i > 5; i--) {
+        Module& right = modules[rawbitsOffset + 4 * size - 8 + (2 * size - i) + 1];
+        right.x = grid[matrixOffset + size - 1 - flip];
+        right.y = grid[matrixOffset + i / 2 - 1];
+        Module& top = modules[rawbitsOffset + 6 * size - 12 + (2 * size - i) + 1];
+        top.x = grid[matrixOffset + i / 2 - 1];
+        top.y = grid[matrixOffset + flip];
+        flip = (flip + 1) % 2;
+      }
+
+      matrixOffset += 2;
+      rawbitsOffset += 8 * size - 16;
+      size -= 4;
+    }
+  }
+
+  std::once_flag placementOnce[2][MAX_LAYERS + 1];
+  std::vector<Module> placements[2][MAX_LAYERS + 1];
+
+  const std::vector<Module>& getPlacement(bool compact, int layers) {
+    std::call_once(placementOnce[compact][layers], [compact, layers]() {
+      buildPlacement(compact, layers, placements[compact][layers]);
+    });
+    return placements[compact][layers];
+  }
 }
         
 Decoder::Table Decoder::getTable(char t) {
@@ -152,38 +222,18 @@ Decoder::Decoder() {
 Ref<DecoderResult> Decoder::decode(Ref<zxing::aztec::AztecDetectorResult> detectorResult) {
   ddata_ = detectorResult;
             
-  // std::printf("getting bits\n");
+  ArrayRef<int> rawCodewords = extractCodewords(detectorResult->getBits());
             
-  Ref<BitMatrix> matrix = detectorResult->getBits();
+  ArrayRef<char> correctedBits = correctBits(rawCodewords);
             
-  if (!ddata_->isCompact()) {
-    // std::printf("removing lines\n");
-    matrix = removeDashedLines(ddata_->getBits());
-  }
-            
-  // std::printf("extracting bits\n");
-  Ref<BitArray> rawbits = extractBits(matrix);
-            
-  // std::printf("correcting bits\n");
-  Ref<BitArray> aCorrectedBits = correctBits(rawbits);
-            
-  // std::printf("decoding bits\n");
-  Ref<String> result = getEncodedData(aCorrectedBits);
-            
-  // std::printf("constructing array\n");
-  ArrayRef<char> arrayOut(aCorrectedBits->getSize());
-  for (int i = 0; i < aCorrectedBits->count(); i++) {
-    arrayOut[i] = (char)aCorrectedBits->get(i);
-  }
-            
-  // std::printf("returning\n");
+  Ref<String> result = getEncodedData(correctedBits);
             
-  return Ref<DecoderResult>(new DecoderResult(arrayOut, result));
+  return Ref<DecoderResult>(new DecoderResult(correctedBits, result));
 }
         
-Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
+Ref<String> Decoder::getEncodedData(const ArrayRef<char>& correctedBits) {
   int endIndex = codewordSize_ * ddata_->getNBDatablocks() - invertedBitCount_;
-  if (endIndex > (int)correctedBits->getSize()) {
+  if (endIndex > correctedBits->size()) {
     // std::printf("invalid input\n");
     throw FormatException("invalid input data");
   }
@@ -192,6 +242,7 @@ Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
   Table table = UPPER;
   int startIndex = 0;
   std::string result;
+  result.reserve(endIndex / 4);
   bool end = false;
   bool shift = false;
   bool switchShift = false;
@@ -257,8 +308,7 @@ Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
         startIndex += size;
                         
         const char *str = getCharacter(table, code);
-        std::string string(str);
-        if ((int)string.find("CTRL_") != -1) {
+        if (strncmp(str, "CTRL_", 5) == 0) {
           table = getTable(str[5]);
                             
           if (str[6] == 'S') {
@@ -268,7 +318,7 @@ Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
             }
           }
         } else {
-          result.append(string);
+          result.append(str);
         }
                         
       }
@@ -287,57 +337,33 @@ Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
             
 }
         
-Ref<BitArray> Decoder::correctBits(Ref<zxing::BitArray> rawbits) {
-  //return rawbits;
-  // std::printf("decoding stuff:%d datablocks in %d layers\n", ddata_->getNBDatablocks(), ddata_->getNBLayers());
-            
+ArrayRef<char> Decoder::correctBits(ArrayRef<int> rawCodewords) {
   Ref<GenericGF> gf = GenericGF::AZTEC_DATA_6;
             
-  if (ddata_->getNBLayers() <= 2) {
-    codewordSize_ = 6;
+  switch (codewordSize_) {
+  case 6:
     gf = GenericGF::AZTEC_DATA_6;
-  } else if (ddata_->getNBLayers() <= 8) {
-    codewordSize_ = 8;
+    break;
+  case 8:
     gf = GenericGF::AZTEC_DATA_8;
-  } else if (ddata_->getNBLayers() <= 22) {
-    codewordSize_ = 10;
+    break;
+  case 10:
     gf = GenericGF::AZTEC_DATA_10;
-  } else {
-    codewordSize_ = 12;
+    break;
+  default:
     gf = GenericGF::AZTEC_DATA_12;
+    break;
   }
             
   int numDataCodewords = ddata_->getNBDatablocks();
-  int numECCodewords;
-  int offset;
-            
-  if (ddata_->isCompact()) {
-    offset = NB_BITS_COMPACT[ddata_->getNBLayers()] - numCodewords_ * codewordSize_;
-    numECCodewords = NB_DATABLOCK_COMPACT[ddata_->getNBLayers()] - numDataCodewords;
-  } else {
-    offset = NB_BITS[ddata_->getNBLayers()] - numCodewords_ * codewordSize_;
-    numECCodewords = NB_DATABLOCK[ddata_->getNBLayers()] - numDataCodewords;
-  }
-            
-  ArrayRef<int> dataWords(numCodewords_);
-            
-  for (int i = 0; i < numCodewords_; i++) {
-    int flag = 1;
-    for (int j = 1; j <= codewordSize_; j++) {
-      if (rawbits->get(codewordSize_ * i + codewordSize_ - j + offset)) {
-        dataWords[i] += flag;
-      }
-      flag <<= 1;
-    }
-                
-    //
-    //
-    //
+  if (numDataCodewords > numCodewords_) {
+    throw FormatException("invalid input data");
   }
+  int numECCodewords = numCodewords_ - numDataCodewords;
             
   try {
     ReedSolomonDecoder rsDecoder(gf);
-    rsDecoder.decode(dataWords, numECCodewords);
+    rsDecoder.decode(rawCodewords, numECCodewords);
   } catch (ReedSolomonException const& ignored) {
     (void)ignored;
     // std::printf("got reed solomon exception:%s, throwing formatexception\n", rse.what());
@@ -347,148 +373,79 @@ Ref<BitArray> Decoder::correctBits(Ref<zxing::BitArray> rawbits) {
     // std::printf("illegal argument exception: %s", iae.what());
   }
             
-  offset = 0;
+  // A codeword whose leading bits are all the same colour has its last bit
+  // inverted by the encoder; that bit carries no data
+  int allOnes = (1 << (codewordSize_ - 1)) - 1;
   invertedBitCount_ = 0;
             
-  Ref<BitArray> correctedBits(new BitArray(numDataCodewords * codewordSize_));
+  ArrayRef<char> correctedBits(numDataCodewords * codewordSize_);
+  int index = 0;
   for (int i = 0; i < numDataCodewords; i++) {
+    int dataWord = rawCodewords[i];
+    int length = codewordSize_;
                 
-    bool seriesColor = false;
-    int seriesCount = 0;
-    int flag = 1 << (codewordSize_ - 1);
-                
-    for (int j = 0; j < codewordSize_; j++) {
-                    
-      bool color = (dataWords[i] & flag) == flag;
-                    
-      if (seriesCount == codewordSize_ - 1) {
-                        
-        if (color == seriesColor) {
-          throw FormatException("bit was not inverted");
-        }
-                        
-        seriesColor = false;
-        seriesCount = 0;
-        offset++;
-        invertedBitCount_++;
-                        
-      } else {
-                        
-        if (seriesColor == color) {
-          seriesCount++;
-        } else {
-          seriesCount = 1;
-          seriesColor = color;
-        }
-                        
-        if (color) correctedBits->set(i * codewordSize_ + j - offset);
-                        
+    int leading = dataWord >> 1;
+    if (leading == 0 || leading == allOnes) {
+      if ((dataWord & 1) == (leading & 1)) {
+        throw FormatException("bit was not inverted");
       }
-                    
-      flag = ((unsigned int)flag) >> 1;
-                    
+      dataWord = leading;
+      length--;
+      invertedBitCount_++;
+    }
+                
+    for (int j = length - 1; j >= 0; j--) {
+      correctedBits[index++] = (char)((dataWord >> j) & 1);
     }
   }
             
   return correctedBits;
 }
         
-Ref<BitArray> Decoder::extractBits(Ref<zxing::BitMatrix> matrix) {
-  std::vector<bool> rawbits;
-            
-  if (ddata_->isCompact()) {
-    if (ddata_->getNBLayers() > 5) { //NB_BITS_COMPACT length
-      throw FormatException("data is too long");
-    }
-    rawbits = std::vector<bool>(NB_BITS_COMPACT[ddata_->getNBLayers()]);
-    numCodewords_ = NB_DATABLOCK_COMPACT[ddata_->getNBLayers()];
-  } else {
-    if (ddata_->getNBLayers() > 33) { //NB_BITS length
-      throw FormatException("data is too long");
-    }
-    rawbits = std::vector<bool>(NB_BITS[ddata_->getNBLayers()]);
-    numCodewords_ = NB_DATABLOCK[ddata_->getNBLayers()];
+ArrayRef<int> Decoder::extractCodewords(Ref<zxing::BitMatrix> matrix) {
+  bool compact = ddata_->isCompact();
+  int layers = ddata_->getNBLayers();
+  if (layers < 1 || layers > (compact ? MAX_COMPACT_LAYERS : MAX_LAYERS)) {
+    throw FormatException("data is too long");
   }
-            
-  int layer = ddata_->getNBLayers();
-  int size = matrix->getHeight();
-  int rawbitsOffset = 0;
-  int matrixOffset = 0;
-            
-
-  while (layer != 0) {
-                
-    int flip = 0;
-    for (int i = 0; i < 2 * size - 4; i++) {
-      rawbits[rawbitsOffset + i] = matrix->get(matrixOffset + flip, matrixOffset + i / 2);
-      rawbits[rawbitsOffset + 2 * size - 4 + i] = matrix->get(matrixOffset + i / 2, matrixOffset + size - 1 - flip);
-      flip = (flip + 1) % 2;
-    }
-                
-    flip = 0;
-    for (int i = 2 * size + 1; i > 5; i--) {
-      rawbits[rawbitsOffset + 4 * size - 8 + (2 * size - i) + 1] =
-        matrix->get(matrixOffset + size - 1 - flip, matrixOffset + i / 2 - 1);
-      rawbits[rawbitsOffset + 6 * size - 12 + (2 * size - i) + 1] =
-        matrix->get(matrixOffset + i / 2 - 1, matrixOffset + flip);
-      flip = (flip + 1) % 2;
-    }
-                
-    matrixOffset += 2;
-    rawbitsOffset += 8 * size - 16;
-    layer--;
-    size -= 4;
-                
+  int dimension = AztecDetectorResult::getDimension(compact, layers);
+  if ((int)matrix->getWidth() != dimension || (int)matrix->getHeight() != dimension) {
+    throw FormatException("symbol size does not match layer count");
   }
             
-  Ref<BitArray> returnValue(new BitArray(rawbits.size()));
-  for (int i = 0; i < (int)rawbits.size(); i++) {
-    if (rawbits[i]) returnValue->set(i);
+  if (layers <= 2) {
+    codewordSize_ = 6;
+  } else if (layers <= 8) {
+    codewordSize_ = 8;
+  } else if (layers <= 22) {
+    codewordSize_ = 10;
+  } else {
+    codewordSize_ = 12;
   }
+  numCodewords_ = compact ? NB_DATABLOCK_COMPACT[layers] : NB_DATABLOCK[layers];
             
-  return returnValue;
-            
-}
-        
-Ref<BitMatrix> Decoder::removeDashedLines(Ref<zxing::BitMatrix> matrix) {
-  int nbDashed = 1 + 2 * ((matrix->getWidth() - 1) / 2 / 16);
-  Ref<BitMatrix> newMatrix(new BitMatrix(matrix->getWidth() - nbDashed, matrix->getHeight() - nbDashed));
-            
-  int nx = 0;
+  // the codewords are right-aligned in the layers, the leading bits are padding
+  const std::vector<Module>& placement = getPlacement(compact, layers);
+  const Module* module = &placement[placement.size() - numCodewords_ * codewordSize_];
+  const BitMatrix& bits = *matrix;
             
-  for (int x = 0; x < (int)matrix->getWidth(); x++) {
-                
-    if ((matrix->getWidth() / 2 - x) % 16 == 0) {
-      continue;
-    }
-                
-    int ny = 0;
-    for (int y = 0; y < (int)matrix->getHeight(); y++) {
-                    
-      if ((matrix->getWidth() / 2 - y) % 16 == 0) {
-        continue;
-      }
-                    
-      if (matrix->get(x, y)) {
-        newMatrix->set(nx, ny);
-      }
-      ny++;
-                    
+  ArrayRef<int> codewords(numCodewords_);
+  for (int i = 0; i < numCodewords_; i++) {
+    int codeword = 0;
+    for (int j = 0; j < codewordSize_; j++, module++) {
+      codeword = (codeword << 1) | (bits.get(module->x, module->y) ? 1 : 0);
     }
-    nx++;
-                
+    codewords[i] = codeword;
   }
-  return newMatrix;
+            
+  return codewords;
 }
         
-int Decoder::readCode(Ref<zxing::BitArray> rawbits, int startIndex, int length) {
+int Decoder::readCode(const ArrayRef<char>& bits, int startIndex, int length) {
   int res = 0;
             
   for (int i = startIndex; i < startIndex + length; i++) {
-    res <<= 1;
-    if (rawbits->get(i)) {
-      res ++;
-    }
+    res = (res << 1) | bits[i];
   }
             
   return res;
@@ -51,11 +51,10 @@ class Decoder : public Counted {
   Ref<AztecDetectorResult> ddata_;
   int invertedBitCount_;
             
-  Ref<String> getEncodedData(Ref<BitArray> correctedBits);
-  Ref<BitArray> correctBits(Ref<BitArray> rawbits);
-  Ref<BitArray> extractBits(Ref<BitMatrix> matrix);
-  static Ref<BitMatrix> removeDashedLines(Ref<BitMatrix> matrix);
-  static int readCode(Ref<BitArray> rawbits, int startIndex, int length);
+  Ref<String> getEncodedData(const ArrayRef<char>& correctedBits);
+  ArrayRef<char> correctBits(ArrayRef<int> rawCodewords);
+  ArrayRef<int> extractCodewords(Ref<BitMatrix> matrix);
+  static int readCode(const ArrayRef<char>& bits, int startIndex, int length);
             
             
  public:
@@ -49,9 +49,10 @@ Detector::Detector(Ref<BitMatrix> image):
 }
         
 Ref<AztecDetectorResult> Detector::detect() {
-  Ref<Point> pCenter = getMatrixCenter();
+  Point pCenter = getMatrixCenter();
             
-  std::vector<Ref<Point> > bullEyeCornerPoints = getBullEyeCornerPoints(pCenter);
+  Point bullEyeCornerPoints[4];
+  getBullEyeCornerPoints(pCenter, bullEyeCornerPoints);
             
   extractParameters(bullEyeCornerPoints);
   
@@ -69,24 +70,22 @@ Ref<AztecDetectorResult> Detector::detect() {
   return Ref<AztecDetectorResult>(new AztecDetectorResult(bits, corners, compact_, nbDataBlocks_, nbLayers_));
 }
         
-void Detector::extractParameters(std::vector<Ref<Point> > bullEyeCornerPoints) {
+void Detector::extractParameters(const Point bullEyeCornerPoints[]) {
   int twoCenterLayers = 2 * nbCenterLayers_;
-  // get the bits around the bull's eye
-  Ref<BitArray> resab = sampleLine(bullEyeCornerPoints[0], bullEyeCornerPoints[1], twoCenterLayers+1);
-  Ref<BitArray> resbc = sampleLine(bullEyeCornerPoints[1], bullEyeCornerPoints[2], twoCenterLayers+1);
-  Ref<BitArray> rescd = sampleLine(bullEyeCornerPoints[2], bullEyeCornerPoints[3], twoCenterLayers+1);
-  Ref<BitArray> resda = sampleLine(bullEyeCornerPoints[3], bullEyeCornerPoints[0], twoCenterLayers+1);
+  // get the bits around the bull's eye, first sample in the most significant bit
+  int sides[4];
+  for (int i = 0; i < 4; i++) {
+    sides[i] = sampleLine(bullEyeCornerPoints[i], bullEyeCornerPoints[(i+1)%4], twoCenterLayers+1);
+  }
         
   // determin the orientation of the matrix
-  if (resab->get(0) && resab->get(twoCenterLayers)) {
-    shift_ = 0;
-  } else if (resbc->get(0) && resbc->get(twoCenterLayers)) {
-    shift_ = 1;
-  } else if (rescd->get(0) && rescd->get(twoCenterLayers)) {
-    shift_ = 2;
-  } else if (resda->get(0) && resda->get(twoCenterLayers)) {
-    shift_ = 3;
-  } else {
+  int cornerMask = (1 << twoCenterLayers) | 1;
+  for (shift_ = 0; shift_ < 4; shift_++) {
+    if ((sides[shift_] & cornerMask) == cornerMask) {
+      break;
+    }
+  }
+  if (shift_ == 4) {
     // std::printf("could not detemine orientation\n");
     throw ReaderException("could not determine orientation");
   }
@@ -95,70 +94,48 @@ void Detector::extractParameters(std::vector<Ref<Point> > bullEyeCornerPoints) {
   //
   //c      b
             
-  //flatten the bits in a single array
-  Ref<BitArray> parameterData(new BitArray(compact_?28:40));
-  Ref<BitArray> shiftedParameterData(new BitArray(compact_?28:40));
-            
-  if (compact_) {
-    for (int i = 0; i < 7; i++) {
-      if (resab->get(2+i)) shiftedParameterData->set(i);
-      if (resbc->get(2+i)) shiftedParameterData->set(i+7);
-      if (rescd->get(2+i)) shiftedParameterData->set(i+14);
-      if (resda->get(2+i)) shiftedParameterData->set(i+21);
-    }
-    for (int i = 0; i < 28; i++) {
-      if (shiftedParameterData->get((i+shift_*7)%28)) parameterData->set(i);
-    }
-                
-  } else {
-    for (int i = 0; i < 11; i++) {
-      if (i < 5) {
-        if (resab->get(2+i)) shiftedParameterData->set(i);
-        if (resbc->get(2+i)) shiftedParameterData->set(i+10);
-        if (rescd->get(2+i)) shiftedParameterData->set(i+20);
-        if (resda->get(2+i)) shiftedParameterData->set(i+30);
-      }
-      if (i > 5) {
-        if (resab->get(2+i)) shiftedParameterData->set(i-1);
-        if (resbc->get(2+i)) shiftedParameterData->set(i+9);
-        if (rescd->get(2+i)) shiftedParameterData->set(i+19);
-        if (resda->get(2+i)) shiftedParameterData->set(i+29);
-      }
-    }
-    for (int i = 0; i < 40; i++) {
-      if (shiftedParameterData->get((i+shift_*10)%40)) parameterData->set(i);
+  // flatten the bits in a single word, starting with the side the orientation
+  // marks point at; a compact side carries the 7 modules between its corners,
+  // a full one 10, skipping the reference grid line in the middle
+  int64_t parameterData = 0;
+  for (int i = 0; i < 4; i++) {
+    int side = sides[(shift_+i)%4];
+    if (compact_) {
+      parameterData = (parameterData << 7) | ((side >> 2) & 0x7F);
+    } else {
+      parameterData = (parameterData << 10) | ((side >> 3) & 0x3E0) | ((side >> 2) & 0x1F);
     }
   }
             
-  correctParameterData(parameterData, compact_);
-            
-  getParameters(parameterData);
+  getParameters(correctParameterData(parameterData, compact_));
 }
         
 ArrayRef< Ref<ResultPoint> >
-Detector::getMatrixCornerPoints(std::vector<Ref<Point> > bullEyeCornerPoints) {
-  float ratio = (2 * nbLayers_ + (nbLayers_ > 4 ? 1 : 0) + (nbLayers_ - 4) / 8) / (2.0f * nbCenterLayers_);
+Detector::getMatrixCornerPoints(const Point bullEyeCornerPoints[]) {
+  // modules from the edge of the 11 or 15 module core to the edge of the symbol
+  int margin = (AztecDetectorResult::getDimension(compact_, nbLayers_) - (compact_ ? 11 : 15)) / 2;
+  float ratio = margin / (2.0f * nbCenterLayers_);
             
-  int dx = bullEyeCornerPoints[0]->getX() - bullEyeCornerPoints[2]->getX();
+  int dx = bullEyeCornerPoints[0].getX() - bullEyeCornerPoints[2].getX();
   dx += dx > 0 ? 1 : -1;
-  int dy = bullEyeCornerPoints[0]->getY() - bullEyeCornerPoints[2]->getY();
+  int dy = bullEyeCornerPoints[0].getY() - bullEyeCornerPoints[2].getY();
   dy += dy > 0 ? 1 : -1;
             
-  int targetcx = MathUtils::round(bullEyeCornerPoints[2]->getX() - ratio * dx);
-  int targetcy = MathUtils::round(bullEyeCornerPoints[2]->getY() - ratio * dy);
+  int targetcx = MathUtils::round(bullEyeCornerPoints[2].getX() - ratio * dx);
+  int targetcy = MathUtils::round(bullEyeCornerPoints[2].getY() - ratio * dy);
             
-  int targetax = MathUtils::round(bullEyeCornerPoints[0]->getX() + ratio * dx);
-  int targetay = MathUtils::round(bullEyeCornerPoints[0]->getY() + ratio * dy);
+  int targetax = MathUtils::round(bullEyeCornerPoints[0].getX() + ratio * dx);
+  int targetay = MathUtils::round(bullEyeCornerPoints[0].getY() + ratio * dy);
             
-  dx = bullEyeCornerPoints[1]->getX() - bullEyeCornerPoints[3]->getX();
+  dx = bullEyeCornerPoints[1].getX() - bullEyeCornerPoints[3].getX();
   dx += dx > 0 ? 1 : -1;
-  dy = bullEyeCornerPoints[1]->getY() - bullEyeCornerPoints[3]->getY();
+  dy = bullEyeCornerPoints[1].getY() - bullEyeCornerPoints[3].getY();
   dy += dy > 0 ? 1 : -1;
             
-  int targetdx = MathUtils::round(bullEyeCornerPoints[3]->getX() - ratio * dx);
-  int targetdy = MathUtils::round(bullEyeCornerPoints[3]->getY() - ratio * dy);
-  int targetbx = MathUtils::round(bullEyeCornerPoints[1]->getX() + ratio * dx);
-  int targetby = MathUtils::round(bullEyeCornerPoints[1]->getY() + ratio * dy);
+  int targetdx = MathUtils::round(bullEyeCornerPoints[3].getX() - ratio * dx);
+  int targetdy = MathUtils::round(bullEyeCornerPoints[3].getY() - ratio * dy);
+  int targetbx = MathUtils::round(bullEyeCornerPoints[1].getX() + ratio * dx);
+  int targetby = MathUtils::round(bullEyeCornerPoints[1].getY() + ratio * dy);
             
   if (!isValid(targetax, targetay) ||
       !isValid(targetbx, targetby) ||
@@ -176,7 +153,7 @@ Detector::getMatrixCornerPoints(std::vector<Ref<Point> > bullEyeCornerPoints) {
   return ArrayRef< Ref<ResultPoint> >(array);
 }
         
-void Detector::correctParameterData(Ref<zxing::BitArray> parameterData, bool compact) {
+int Detector::correctParameterData(int64_t parameterData, bool compact) {
   int numCodewords;
   int numDataCodewords;
             
@@ -194,13 +171,7 @@ void Detector::correctParameterData(Ref<zxing::BitArray> parameterData, bool com
             
   int codewordSize = 4;
   for (int i = 0; i < numCodewords; i++) {
-    int flag = 1;
-    for (int j = 1; j <= codewordSize; j++) {
-      if (parameterData->get(codewordSize*i + codewordSize - j)) {
-        parameterWords[i] += flag;
-      }
-      flag <<= 1;
-    }
+    parameterWords[i] = (int)(parameterData >> (codewordSize * (numCodewords - 1 - i))) & 0xF;
   }
                         
   try {
@@ -213,31 +184,26 @@ void Detector::correctParameterData(Ref<zxing::BitArray> parameterData, bool com
     throw ReaderException("failed to decode parameter data");
   }
             
-  parameterData->clear();
+  int result = 0;
   for (int i = 0; i < numDataCodewords; i++) {
-    int flag = 1;
-    for (int j = 1; j <= codewordSize; j++) {
-      if ((parameterWords[i] & flag) == flag) {
-        parameterData->set(i*codewordSize+codewordSize-j);
-      }
-      flag <<= 1;
-    }
+    result = (result << codewordSize) | parameterWords[i];
   }
+  return result;
 }
         
-std::vector<Ref<Point> > Detector::getBullEyeCornerPoints(Ref<zxing::aztec::Point> pCenter) {
-  Ref<Point> pina = pCenter;
-  Ref<Point> pinb = pCenter;
-  Ref<Point> pinc = pCenter;
-  Ref<Point> pind = pCenter;
+void Detector::getBullEyeCornerPoints(const Point& pCenter, Point bullEyeCornerPoints[]) {
+  Point pina = pCenter;
+  Point pinb = pCenter;
+  Point pinc = pCenter;
+  Point pind = pCenter;
             
   bool color = true;
             
   for (nbCenterLayers_ = 1; nbCenterLayers_ < 9; nbCenterLayers_++) {
-    Ref<Point> pouta = getFirstDifferent(pina, color, 1, -1);
-    Ref<Point> poutb = getFirstDifferent(pinb, color, 1, 1);
-    Ref<Point> poutc = getFirstDifferent(pinc, color, -1, 1);
-    Ref<Point> poutd = getFirstDifferent(pind, color, -1, -1);
+    Point pouta = getFirstDifferent(pina, color, 1, -1);
+    Point poutb = getFirstDifferent(pinb, color, 1, 1);
+    Point poutc = getFirstDifferent(pinc, color, -1, 1);
+    Point poutd = getFirstDifferent(pind, color, -1, -1);
             
     //d    a
     //
@@ -268,21 +234,21 @@ std::vector<Ref<Point> > Detector::getBullEyeCornerPoints(Ref<zxing::aztec::Poin
             
   float ratio = 0.75f*2 / (2*nbCenterLayers_-3);
             
-  int dx = pina->getX() - pind->getX();
-  int dy = pina->getY() - pinc->getY();
+  int dx = pina.getX() - pind.getX();
+  int dy = pina.getY() - pinc.getY();
             
-  int targetcx = MathUtils::round(pinc->getX() - ratio * dx);
-  int targetcy = MathUtils::round(pinc->getY() - ratio * dy);
-  int targetax = MathUtils::round(pina->getX() + ratio * dx);
-  int targetay = MathUtils::round(pina->getY() + ratio * dy);
+  int targetcx = MathUtils::round(pinc.getX() - ratio * dx);
+  int targetcy = MathUtils::round(pinc.getY() - ratio * dy);
+  int targetax = MathUtils::round(pina.getX() + ratio * dx);
+  int targetay = MathUtils::round(pina.getY() + ratio * dy);
             
-  dx = pinb->getX() - pind->getX();
-  dy = pinb->getY() - pind->getY();
+  dx = pinb.getX() - pind.getX();
+  dy = pinb.getY() - pind.getY();
             
-  int targetdx = MathUtils::round(pind->getX() - ratio * dx);
-  int targetdy = MathUtils::round(pind->getY() - ratio * dy);
-  int targetbx = MathUtils::round(pinb->getX() + ratio * dx);
-  int targetby = MathUtils::round(pinb->getY() + ratio * dy);
+  int targetdx = MathUtils::round(pind.getX() - ratio * dx);
+  int targetdy = MathUtils::round(pind.getY() - ratio * dy);
+  int targetbx = MathUtils::round(pinb.getX() + ratio * dx);
+  int targetby = MathUtils::round(pinb.getY() + ratio * dy);
             
   if (!isValid(targetax, targetay) ||
       !isValid(targetbx, targetby) ||
@@ -291,17 +257,13 @@ std::vector<Ref<Point> > Detector::getBullEyeCornerPoints(Ref<zxing::aztec::Poin
     throw ReaderException("bullseye extends over image bounds");
   }
             
-  std::vector<Ref<Point> > returnValue;
-  returnValue.push_back(Ref<Point>(new Point(targetax, targetay)));
-  returnValue.push_back(Ref<Point>(new Point(targetbx, targetby)));
-  returnValue.push_back(Ref<Point>(new Point(targetcx, targetcy)));
-  returnValue.push_back(Ref<Point>(new Point(targetdx, targetdy)));
-            
-  return returnValue;
-            
+  bullEyeCornerPoints[0] = Point(targetax, targetay);
+  bullEyeCornerPoints[1] = Point(targetbx, targetby);
+  bullEyeCornerPoints[2] = Point(targetcx, targetcy);
+  bullEyeCornerPoints[3] = Point(targetdx, targetdy);
 }
         
-Ref<Point> Detector::getMatrixCenter() {
+Point Detector::getMatrixCenter() {
   Ref<ResultPoint> pointA, pointB, pointC, pointD;
   try {
                 
@@ -317,10 +279,10 @@ Ref<Point> Detector::getMatrixCenter() {
     int cx = image_->getWidth() / 2;
     int cy = image_->getHeight() / 2;
                 
-    pointA = getFirstDifferent(Ref<Point>(new Point(cx+7, cy-7)), false,  1, -1)->toResultPoint();
-    pointB = getFirstDifferent(Ref<Point>(new Point(cx+7, cy+7)), false,  1,  1)->toResultPoint();
-    pointC = getFirstDifferent(Ref<Point>(new Point(cx-7, cy+7)), false, -1, -1)->toResultPoint();
-    pointD = getFirstDifferent(Ref<Point>(new Point(cx-7, cy-7)), false, -1, -1)->toResultPoint();
+    pointA = getFirstDifferent(Point(cx+7, cy-7), false,  1, -1).toResultPoint();
+    pointB = getFirstDifferent(Point(cx+7, cy+7), false,  1,  1).toResultPoint();
+    pointC = getFirstDifferent(Point(cx-7, cy+7), false, -1, -1).toResultPoint();
+    pointD = getFirstDifferent(Point(cx-7, cy-7), false, -1, -1).toResultPoint();
                                       
   }
             
@@ -338,17 +300,17 @@ Ref<Point> Detector::getMatrixCenter() {
   } catch (NotFoundException const& e) {
     (void)e;
                 
-    pointA = getFirstDifferent(Ref<Point>(new Point(cx+7, cy-7)), false,  1, -1)->toResultPoint();
-    pointB = getFirstDifferent(Ref<Point>(new Point(cx+7, cy+7)), false,  1,  1)->toResultPoint();
-    pointC = getFirstDifferent(Ref<Point>(new Point(cx-7, cy+7)), false, -1, 1)->toResultPoint();
-    pointD = getFirstDifferent(Ref<Point>(new Point(cx-7, cy-7)), false, -1, -1)->toResultPoint();
+    pointA = getFirstDifferent(Point(cx+7, cy-7), false,  1, -1).toResultPoint();
+    pointB = getFirstDifferent(Point(cx+7, cy+7), false,  1,  1).toResultPoint();
+    pointC = getFirstDifferent(Point(cx-7, cy+7), false, -1, 1).toResultPoint();
+    pointD = getFirstDifferent(Point(cx-7, cy-7), false, -1, -1).toResultPoint();
                 
   }
             
   cx = MathUtils::round((pointA->getX() + pointD->getX() + pointB->getX() + pointC->getX()) / 4.0f);
   cy = MathUtils::round((pointA->getY() + pointD->getY() + pointB->getY() + pointC->getY()) / 4.0f);
             
-  return Ref<Point>(new Point(cx, cy));
+  return Point(cx, cy);
             
 }
         
@@ -357,16 +319,7 @@ Ref<BitMatrix> Detector::sampleGrid(Ref<zxing::BitMatrix> image,
                                     Ref<zxing::ResultPoint> bottomLeft,
                                     Ref<zxing::ResultPoint> bottomRight,
                                     Ref<zxing::ResultPoint> topRight) {
-  int dimension;
-  if (compact_) {
-    dimension = 4 * nbLayers_+11;
-  } else {
-    if (nbLayers_ <= 4) {
-      dimension = 4 * nbLayers_ + 15;
-    } else {
-      dimension = 4 * nbLayers_ + 2 * ((nbLayers_-4)/8 + 1) + 15;
-    }
-  }
+  int dimension = AztecDetectorResult::getDimension(compact_, nbLayers_);
             
   GridSampler sampler = GridSampler::getInstance();
             
@@ -390,52 +343,27 @@ Ref<BitMatrix> Detector::sampleGrid(Ref<zxing::BitMatrix> image,
                             bottomLeft->getY());
 }
         
-void Detector::getParameters(Ref<zxing::BitArray> parameterData) {
-  nbLayers_ = 0;
-  nbDataBlocks_ = 0;
-            
-  int nbBitsForNbLayers;
-  int nbBitsForNbDatablocks;
-            
-  if (compact_) {
-    nbBitsForNbLayers = 2;
-    nbBitsForNbDatablocks = 6;
-  } else {
-    nbBitsForNbLayers = 5;
-    nbBitsForNbDatablocks = 11;
-  }
-            
-  for (int i = 0; i < nbBitsForNbLayers; i++) {
-    nbLayers_ <<= 1;
-    if (parameterData->get(i)) {
-      nbLayers_++;
-    }
-  }
-            
-  for (int i = nbBitsForNbLayers; i < nbBitsForNbLayers + nbBitsForNbDatablocks; i++) {
-    nbDataBlocks_ <<= 1;
-    if (parameterData->get(i)) {
-      nbDataBlocks_++;
-    }
-  }
+void Detector::getParameters(int parameterData) {
+  int nbBitsForNbDatablocks = compact_ ? 6 : 11;
             
-  nbLayers_++;
-  nbDataBlocks_++;
+  nbLayers_ = (parameterData >> nbBitsForNbDatablocks) + 1;
+  nbDataBlocks_ = (parameterData & ((1 << nbBitsForNbDatablocks) - 1)) + 1;
 }
         
-Ref<BitArray> Detector::sampleLine(Ref<zxing::aztec::Point> p1, Ref<zxing::aztec::Point> p2, int size) {
-  Ref<BitArray> res(new BitArray(size));
+int Detector::sampleLine(const Point& p1, const Point& p2, int size) {
+  int res = 0;
             
   float d = distance(p1, p2);
   float moduleSize = d / (size-1);
-  float dx = moduleSize * float(p2->getX() - p1->getX())/d;
-  float dy = moduleSize * float(p2->getY() - p1->getY())/d;
+  float dx = moduleSize * float(p2.getX() - p1.getX())/d;
+  float dy = moduleSize * float(p2.getY() - p1.getY())/d;
   
-  float px = float(p1->getX());
-  float py = float(p1->getY());
+  float px = float(p1.getX());
+  float py = float(p1.getY());
             
   for (int i = 0; i < size; i++) {
-    if (image_->get(MathUtils::round(px), MathUtils::round(py))) res->set(i);
+    res <<= 1;
+    if (image_->get(MathUtils::round(px), MathUtils::round(py))) res |= 1;
     px+=dx;
     py+=dy;
   }
@@ -443,36 +371,36 @@ Ref<BitArray> Detector::sampleLine(Ref<zxing::aztec::Point> p1, Ref<zxing::aztec
   return res;
 }
         
-bool Detector::isWhiteOrBlackRectangle(Ref<zxing::aztec::Point> p1,
-                                       Ref<zxing::aztec::Point> p2,
-                                       Ref<zxing::aztec::Point> p3,
-                                       Ref<zxing::aztec::Point> p4) {
+bool Detector::isWhiteOrBlackRectangle(const Point& p1,
+                                       const Point& p2,
+                                       const Point& p3,
+                                       const Point& p4) {
   int corr = 3;
             
-  p1 = new Point(p1->getX() - corr, p1->getY() + corr);
-  p2 = new Point(p2->getX() - corr, p2->getY() - corr);
-  p3 = new Point(p3->getX() + corr, p3->getY() - corr);
-  p4 = new Point(p4->getX() + corr, p4->getY() + corr);
+  Point c1(p1.getX() - corr, p1.getY() + corr);
+  Point c2(p2.getX() - corr, p2.getY() - corr);
+  Point c3(p3.getX() + corr, p3.getY() - corr);
+  Point c4(p4.getX() + corr, p4.getY() + corr);
             
-  int cInit = getColor(p4, p1);
+  int cInit = getColor(c4, c1);
             
   if (cInit == 0) {
     return false;
   }
             
-  int c = getColor(p1, p2);
+  int c = getColor(c1, c2);
             
   if (c != cInit) {
     return false;
   }
             
-  c = getColor(p2, p3);
+  c = getColor(c2, c3);
             
   if (c != cInit) {
     return false;
   }
             
-  c = getColor(p3, p4);
+  c = getColor(c3, c4);
             
   if (c != cInit) {
     return false;
@@ -481,18 +409,18 @@ bool Detector::isWhiteOrBlackRectangle(Ref<zxing::aztec::Point> p1,
   return true;
 }
         
-int Detector::getColor(Ref<zxing::aztec::Point> p1, Ref<zxing::aztec::Point> p2) {
+int Detector::getColor(const Point& p1, const Point& p2) {
   float d = distance(p1, p2);
             
-  float dx = (p2->getX() - p1->getX()) / d;
-  float dy = (p2->getY() - p1->getY()) / d;
+  float dx = (p2.getX() - p1.getX()) / d;
+  float dy = (p2.getY() - p1.getY()) / d;
             
   int error = 0;
             
-  float px = float(p1->getX());
-  float py = float(p1->getY());
+  float px = float(p1.getX());
+  float py = float(p1.getY());
             
-  bool colorModel = image_->get(p1->getX(), p1->getY());
+  bool colorModel = image_->get(p1.getX(), p1.getY());
             
   for (int i = 0; i < d; i++) {
     px += dx;
@@ -512,9 +440,9 @@ int Detector::getColor(Ref<zxing::aztec::Point> p1, Ref<zxing::aztec::Point> p2)
   return (errRatio <= 0.1) == colorModel ? 1 : -1;
 }
         
-Ref<Point> Detector::getFirstDifferent(Ref<zxing::aztec::Point> init, bool color, int dx, int dy) {
-  int x = init->getX() + dx;
-  int y = init->getY() + dy;
+Point Detector::getFirstDifferent(const Point& init, bool color, int dx, int dy) {
+  int x = init.getX() + dx;
+  int y = init.getY() + dy;
             
   while (isValid(x, y) && image_->get(x, y) == color) {
     x += dx;
@@ -536,13 +464,13 @@ Ref<Point> Detector::getFirstDifferent(Ref<zxing::aztec::Point> init, bool color
             
   y -= dy;
             
-  return Ref<Point>(new Point(x, y));
+  return Point(x, y);
 }
 
 bool Detector::isValid(int x, int y) {
   return x >= 0 && x < (int)image_->getWidth() && y > 0 && y < (int)image_->getHeight();
 }
         
-float Detector::distance(Ref<zxing::aztec::Point> a, Ref<zxing::aztec::Point> b) {
-  return sqrtf((float)((a->getX() - b->getX()) * (a->getX() - b->getX()) + (a->getY() - b->getY()) * (a->getY() - b->getY())));
+float Detector::distance(const Point& a, const Point& b) {
+  return sqrtf((float)((a.getX() - b.getX()) * (a.getX() - b.getX()) + (a.getY() - b.getY()) * (a.getY() - b.getY())));
 }
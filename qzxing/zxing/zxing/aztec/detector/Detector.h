@@ -23,6 +23,7 @@
 #define __ZXING_AZTEC_DETECTOR_DETECTOR_H__
 
 #include <vector>
+#include <stdint.h>
 
 #include <zxing/common/BitArray.h>
 #include <zxing/ResultPoint.h>
@@ -33,16 +34,17 @@
 namespace zxing {
 namespace aztec {
 
-class Point : public Counted {
+class Point {
  private:
-  const int x;
-  const int y;
+  int x;
+  int y;
             
  public:
-  Ref<ResultPoint> toResultPoint() { 
+  Ref<ResultPoint> toResultPoint() const {
     return Ref<ResultPoint>(new ResultPoint(float(x), float(y)));
   }
             
+  Point() : x(0), y(0) {}
   Point(int ax, int ay) : x(ax), y(ay) {}
 
   int getX() const { return x; }
@@ -60,26 +62,26 @@ class Detector : public Counted {
   int nbCenterLayers_;
   int shift_;
             
-  void extractParameters(std::vector<Ref<Point> > bullEyeCornerPoints);
-  ArrayRef< Ref<ResultPoint> > getMatrixCornerPoints(std::vector<Ref<Point> > bullEyeCornerPoints);
-  static void correctParameterData(Ref<BitArray> parameterData, bool compact);
-  std::vector<Ref<Point> > getBullEyeCornerPoints(Ref<Point> pCenter);
-  Ref<Point> getMatrixCenter();
+  void extractParameters(const Point bullEyeCornerPoints[]);
+  ArrayRef< Ref<ResultPoint> > getMatrixCornerPoints(const Point bullEyeCornerPoints[]);
+  static int correctParameterData(int64_t parameterData, bool compact);
+  void getBullEyeCornerPoints(const Point& pCenter, Point bullEyeCornerPoints[]);
+  Point getMatrixCenter();
   Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image,
                             Ref<ResultPoint> topLeft,
                             Ref<ResultPoint> bottomLeft,
                             Ref<ResultPoint> bottomRight,
                             Ref<ResultPoint> topRight);
-  void getParameters(Ref<BitArray> parameterData);
-  Ref<BitArray> sampleLine(Ref<Point> p1, Ref<Point> p2, int size);
-  bool isWhiteOrBlackRectangle(Ref<Point> p1,
-                               Ref<Point> p2,
-                               Ref<Point> p3,
-                               Ref<Point> p4);
-  int getColor(Ref<Point> p1, Ref<Point> p2);
-  Ref<Point> getFirstDifferent(Ref<Point> init, bool color, int dx, int dy);
+  void getParameters(int parameterData);
+  int sampleLine(const Point& p1, const Point& p2, int size);
+  bool isWhiteOrBlackRectangle(const Point& p1,
+                               const Point& p2,
+                               const Point& p3,
+                               const Point& p4);
+  int getColor(const Point& p1, const Point& p2);
+  Point getFirstDifferent(const Point& init, bool color, int dx, int dy);
   bool isValid(int x, int y);
-  static float distance(Ref<Point> a, Ref<Point> b);
+  static float distance(const Point& a, const Point& b);
             
  public:
   Detector(Ref<BitMatrix> image);
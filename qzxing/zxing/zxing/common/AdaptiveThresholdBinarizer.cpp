@@ -0,0 +1,200 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  AdaptiveThresholdBinarizer.cpp
+ *  zxing
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/AdaptiveThresholdBinarizer.h>
+
+#include <cmath>
+
+using namespace std;
+using namespace zxing;
+
+namespace {
+  const int MINIMUM_DIMENSION = 40;
+  const int MINIMUM_WINDOW = 15;
+  // Mean method: a pixel is black when it is at most this percentage of the local mean
+  const int MEAN_PERCENT = 85;
+  // Sauvola: t = m * (1 + k * (s / R - 1))
+  const double SAUVOLA_K = 0.2;
+  const double SAUVOLA_R = 128.0;
+
+  inline int clampi(int value, int min, int max) {
+    return value < min ? min : value > max ? max : value;
+  }
+}
+
+AdaptiveThresholdBinarizer::AdaptiveThresholdBinarizer(Ref<LuminanceSource> source, Method method, int windowSize) :
+  GlobalHistogramBinarizer(source), matrix_(NULL), method_(method), windowSize_(windowSize) {
+}
+
+AdaptiveThresholdBinarizer::~AdaptiveThresholdBinarizer() {
+}
+
+Ref<Binarizer>
+AdaptiveThresholdBinarizer::createBinarizer(Ref<LuminanceSource> source) {
+  return Ref<Binarizer> (new AdaptiveThresholdBinarizer(source, method_, windowSize_));
+}
+
+AdaptiveThresholdBinarizer::Method AdaptiveThresholdBinarizer::getMethod() const {
+  return method_;
+}
+
+int AdaptiveThresholdBinarizer::getWindowSize() const {
+  if (windowSize_ > 0) {
+    return windowSize_;
+  }
+  int size = std::min(getWidth(), getHeight()) >> 3;
+  return size < MINIMUM_WINDOW ? MINIMUM_WINDOW : size | 1;
+}
+
+bool AdaptiveThresholdBinarizer::isLargeEnough() const {
+  return getWidth() >= MINIMUM_DIMENSION && getHeight() >= MINIMUM_DIMENSION;
+}
+
+/**
+ * Builds the (width + 1) x (height + 1) summed area tables, with a zero first
+ * row and column so that window sums need no edge checks. Each row is a
+ * running prefix sum added to the row above; the second step has no
+ * dependencies across x and vectorizes. The tables use wrapping unsigned
+ * arithmetic, window sums stay exact as long as a single window fits.
+ */
+void AdaptiveThresholdBinarizer::buildIntegralImage() {
+  if (!sums_.empty()) {
+    return;
+  }
+  const int width = getWidth();
+  const int height = getHeight();
+  const int stride = width + 1;
+  const bool squares = method_ == SAUVOLA;
+
+  luminances_ = getLuminanceSource()->getMatrix();
+  sums_.assign(stride * (height + 1), 0);
+  if (squares) {
+    squares_.assign(stride * (height + 1), 0);
+  }
+
+  std::vector<uint32_t> rowSum(stride, 0);
+  std::vector<uint64_t> rowSquare(squares ? stride : 0, 0);
+  for (int y = 0; y < height; y++) {
+    const unsigned char *pixels = reinterpret_cast<const unsigned char *>(&luminances_[y * width]);
+    uint32_t sum = 0;
+    uint64_t square = 0;
+    for (int x = 0; x < width; x++) {
+      uint32_t pixel = pixels[x];
+      sum += pixel;
+      rowSum[x + 1] = sum;
+      if (squares) {
+        square += pixel * pixel;
+        rowSquare[x + 1] = square;
+      }
+    }
+    const uint32_t *above = &sums_[y * stride];
+    uint32_t *current = &sums_[(y + 1) * stride];
+    for (int x = 1; x < stride; x++) {
+      current[x] = above[x] + rowSum[x];
+    }
+    if (squares) {
+      const uint64_t *aboveSquare = &squares_[y * stride];
+      uint64_t *currentSquare = &squares_[(y + 1) * stride];
+      for (int x = 1; x < stride; x++) {
+        currentSquare[x] = aboveSquare[x] + rowSquare[x];
+      }
+    }
+  }
+}
+
+void AdaptiveThresholdBinarizer::thresholdRow(int y, int radius, Ref<BitArray> const& row) {
+  const int width = getWidth();
+  const int height = getHeight();
+  const int stride = width + 1;
+  const int top = clampi(y - radius, 0, height);
+  const int bottom = clampi(y + radius + 1, 0, height);
+  const uint32_t rows = bottom - top;
+  const uint32_t *sumTop = &sums_[top * stride];
+  const uint32_t *sumBottom = &sums_[bottom * stride];
+  const unsigned char *pixels = reinterpret_cast<const unsigned char *>(&luminances_[y * width]);
+
+  if (method_ == SAUVOLA) {
+    const uint64_t *squareTop = &squares_[top * stride];
+    const uint64_t *squareBottom = &squares_[bottom * stride];
+    for (int x = 0; x < width; x++) {
+      const int left = clampi(x - radius, 0, width);
+      const int right = clampi(x + radius + 1, 0, width);
+      const double count = double((right - left) * rows);
+      const uint32_t sum = sumBottom[right] - sumBottom[left] - sumTop[right] + sumTop[left];
+      const uint64_t square = squareBottom[right] - squareBottom[left] - squareTop[right] + squareTop[left];
+      const double mean = sum / count;
+      const double variance = square / count - mean * mean;
+      const double deviation = variance > 0 ? sqrt(variance) : 0;
+      if (pixels[x] <= mean * (1.0 + SAUVOLA_K * (deviation / SAUVOLA_R - 1.0))) {
+        row->set(x);
+      }
+    }
+  } else {
+    for (int x = 0; x < width; x++) {
+      const int left = clampi(x - radius, 0, width);
+      const int right = clampi(x + radius + 1, 0, width);
+      const uint32_t count = (right - left) * rows;
+      const uint32_t sum = sumBottom[right] - sumBottom[left] - sumTop[right] + sumTop[left];
+      if (uint64_t(pixels[x]) * count * 100 <= uint64_t(sum) * MEAN_PERCENT) {
+        row->set(x);
+      }
+    }
+  }
+}
+
+Ref<BitArray> AdaptiveThresholdBinarizer::getBlackRow(int y, Ref<BitArray> row) {
+  if (matrix_) {
+    return matrix_->getRow(y, row);
+  }
+  if (!isLargeEnough()) {
+    return GlobalHistogramBinarizer::getBlackRow(y, row);
+  }
+  const int width = getWidth();
+  if (row == NULL || static_cast<int>(row->getSize()) < width) {
+    row = new BitArray(width);
+  } else {
+    row->clear();
+  }
+  buildIntegralImage();
+  thresholdRow(y, getWindowSize() >> 1, row);
+  return row;
+}
+
+Ref<BitMatrix> AdaptiveThresholdBinarizer::getBlackMatrix() {
+  if (matrix_) {
+    return matrix_;
+  }
+  if (!isLargeEnough()) {
+    matrix_ = GlobalHistogramBinarizer::getBlackMatrix();
+    return matrix_;
+  }
+  const int width = getWidth();
+  const int height = getHeight();
+  const int radius = getWindowSize() >> 1;
+  buildIntegralImage();
+
+  Ref<BitMatrix> matrix(new BitMatrix(width, height));
+  Ref<BitArray> row(new BitArray(width));
+  for (int y = 0; y < height; y++) {
+    row->clear();
+    thresholdRow(y, radius, row);
+    matrix->setRow(y, row);
+  }
+  matrix_ = matrix;
+  return matrix_;
+}
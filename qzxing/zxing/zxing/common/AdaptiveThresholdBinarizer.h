@@ -0,0 +1,72 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ADAPTIVETHRESHOLDBINARIZER_H__
+#define __ADAPTIVETHRESHOLDBINARIZER_H__
+/*
+ *  AdaptiveThresholdBinarizer.h
+ *  zxing
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <stdint.h>
+#include <zxing/Binarizer.h>
+#include <zxing/common/GlobalHistogramBinarizer.h>
+#include <zxing/common/BitArray.h>
+#include <zxing/common/BitMatrix.h>
+
+namespace zxing {
+
+/**
+ * Local mean (Bradley) or mean and deviation (Sauvola) thresholding over a
+ * square window around every pixel. The window statistics come from summed
+ * area tables built in a single pass over the luminance data, so the cost per
+ * pixel does not depend on the window size. Unlike HybridBinarizer there is no
+ * fixed block grid, which copes better with uneven lighting.
+ */
+class AdaptiveThresholdBinarizer : public GlobalHistogramBinarizer {
+ public:
+  enum Method {
+    MEAN,
+    SAUVOLA
+  };
+
+ private:
+  Ref<BitMatrix> matrix_;
+  ArrayRef<char> luminances_;
+  std::vector<uint32_t> sums_;
+  std::vector<uint64_t> squares_;
+  Method method_;
+  int windowSize_;
+
+ public:
+  AdaptiveThresholdBinarizer(Ref<LuminanceSource> source, Method method = MEAN, int windowSize = 0);
+  virtual ~AdaptiveThresholdBinarizer();
+
+  virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
+  virtual Ref<BitMatrix> getBlackMatrix();
+  Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+
+  Method getMethod() const;
+  // Side of the square window in pixels, 0 picks one from the image size.
+  int getWindowSize() const;
+
+ private:
+  bool isLargeEnough() const;
+  void buildIntegralImage();
+  void thresholdRow(int y, int radius, Ref<BitArray> const& row);
+};
+
+}
+
+#endif
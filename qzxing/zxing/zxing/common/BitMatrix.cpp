@@ -86,6 +86,262 @@ Ref<BitArray> BitMatrix::getRow(int y, Ref<BitArray> row) {
   return row;
 }
 
+void BitMatrix::setRow(int y, Ref<BitArray> row) {
+  std::vector<int>& rowBits = row->getBitArray();
+  if (static_cast<int>(rowBits.size()) < rowSize) {
+    throw IllegalArgumentException("Row is too short for the matrix");
+  }
+  int offset = y * rowSize;
+  for (int x = 0; x < rowSize; x++) {
+    bits[offset + x] = rowBits[x];
+  }
+}
+
+namespace {
+// N.B.: This only works for 32 bit ints ...
+inline int numberOfTrailingZeros(int i) {
+#if defined(__GNUC__)
+  return i == 0 ? 32 : __builtin_ctz(i);
+#else
+  // HD, Figure 5-14
+  int y;
+  if (i == 0) return 32;
+  int n = 31;
+  y = i <<16; if (y != 0) { n = n -16; i = y; }
+  y = i << 8; if (y != 0) { n = n - 8; i = y; }
+  y = i << 4; if (y != 0) { n = n - 4; i = y; }
+  y = i << 2; if (y != 0) { n = n - 2; i = y; }
+  return n - (((unsigned int)(i << 1)) >> 31);
+#endif
+}
+}
+
+int BitMatrix::getNextSet(int x, int y) const {
+  if (x >= width) {
+    return width;
+  }
+  int offset = y * rowSize;
+  int bitsOffset = x >> logBits;
+  int currentBits = bits[offset + bitsOffset];
+  // mask off lesser bits first
+  currentBits &= ~((1 << (x & bitsMask)) - 1);
+  while (currentBits == 0) {
+    if (++bitsOffset == rowSize) {
+      return width;
+    }
+    currentBits = bits[offset + bitsOffset];
+  }
+  int result = (bitsOffset << logBits) + numberOfTrailingZeros(currentBits);
+  return result > width ? width : result;
+}
+
+int BitMatrix::getNextUnset(int x, int y) const {
+  if (x >= width) {
+    return width;
+  }
+  int offset = y * rowSize;
+  int bitsOffset = x >> logBits;
+  int currentBits = ~bits[offset + bitsOffset];
+  // mask off lesser bits first
+  currentBits &= ~((1 << (x & bitsMask)) - 1);
+  while (currentBits == 0) {
+    if (++bitsOffset == rowSize) {
+      return width;
+    }
+    currentBits = ~bits[offset + bitsOffset];
+  }
+  // The padding bits past the width are unset, so this stops at the width at the latest
+  int result = (bitsOffset << logBits) + numberOfTrailingZeros(currentBits);
+  return result > width ? width : result;
+}
+
+namespace {
+inline int bitCount(unsigned int i) {
+#if defined(__GNUC__)
+  return __builtin_popcount(i);
+#else
+  // HD, Figure 5-2
+  i = i - ((i >> 1) & 0x55555555);
+  i = (i & 0x33333333) + ((i >> 2) & 0x33333333);
+  i = (i + (i >> 4)) & 0x0F0F0F0F;
+  return (int)((i * 0x01010101) >> 24);
+#endif
+}
+}
+
+int BitMatrix::countTransitions(int x, int lastX, int y) const {
+  if (lastX <= x) {
+    return 0;
+  }
+  // Bit i of a word's difference is set when bits i and i + 1 differ; the
+  // differences to count are those starting at x up to lastX - 1
+  int offset = y * rowSize;
+  int firstWord = x >> logBits;
+  int lastWord = (lastX - 1) >> logBits;
+  int transitions = 0;
+  for (int i = firstWord; i <= lastWord; i++) {
+    unsigned int current = (unsigned int)bits[offset + i];
+    unsigned int next = i + 1 < rowSize ? (unsigned int)bits[offset + i + 1] : 0;
+    unsigned int difference = current ^ ((current >> 1) | (next << 31));
+    if (i == firstWord) {
+      difference &= ~0u << (x & bitsMask);
+    }
+    if (i == lastWord) {
+      difference &= ~0u >> (bitsMask - ((lastX - 1) & bitsMask));
+    }
+    transitions += bitCount(difference);
+  }
+  return transitions;
+}
+
+bool BitMatrix::isAnySet(int left, int top, int right, int bottom) const {
+  int firstWord = left >> logBits;
+  int lastWord = right >> logBits;
+  unsigned int firstMask = ~0u << (left & bitsMask);
+  unsigned int lastMask = ~0u >> (bitsMask - (right & bitsMask));
+  for (int y = top; y <= bottom; y++) {
+    int offset = y * rowSize;
+    if (firstWord == lastWord) {
+      if ((unsigned int)bits[offset + firstWord] & firstMask & lastMask) {
+        return true;
+      }
+      continue;
+    }
+    if (((unsigned int)bits[offset + firstWord] & firstMask) ||
+        ((unsigned int)bits[offset + lastWord] & lastMask)) {
+      return true;
+    }
+    for (int i = firstWord + 1; i < lastWord; i++) {
+      if (bits[offset + i] != 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+int BitMatrix::getNextUnsetColumn(int x, int top, int bottom, int step) const {
+  while (x >= 0 && x < width) {
+    int wordOffset = x >> logBits;
+    // Bit i is set when column i of this word has a set bit in one of the rows
+    unsigned int used = 0;
+    for (int y = top; y <= bottom && used != ~0u; y++) {
+      used |= (unsigned int)bits[y * rowSize + wordOffset];
+    }
+    unsigned int unused = ~used;
+    if (step > 0) {
+      unused &= ~0u << (x & bitsMask);
+      if (unused != 0) {
+        // The padding bits past the width are unset, so the result may land past it
+        int result = (wordOffset << logBits) + numberOfTrailingZeros((int)unused);
+        return result > width ? width : result;
+      }
+      x = (wordOffset + 1) << logBits;
+    } else {
+      unused &= ~0u >> (bitsMask - (x & bitsMask));
+      if (unused != 0) {
+        int result = wordOffset << logBits;
+        while (unused >>= 1) {
+          result++;
+        }
+        return result;
+      }
+      x = (wordOffset << logBits) - 1;
+    }
+  }
+  return step > 0 ? width : -1;
+}
+
+namespace {
+// Transposes a 32x32 bit block in place, bit x of word y ends up as bit y
+// of word x. Quadrants are swapped recursively, HD, Figure 7-3.
+void transpose32(unsigned int *block) {
+  unsigned int mask = 0x0000FFFF;
+  for (int j = 16; j != 0; j >>= 1, mask ^= (mask << j)) {
+    for (int k = 0; k < 32; k = ((k | j) + 1) & ~j) {
+      unsigned int t = ((block[k] >> j) ^ block[k | j]) & mask;
+      block[k] ^= t << j;
+      block[k | j] ^= t;
+    }
+  }
+}
+}
+
+Ref<BitMatrix> BitMatrix::transpose() const {
+  Ref<BitMatrix> result(new BitMatrix(height, width));
+  int resultRowSize = result->rowSize;
+  unsigned int block[32];
+  for (int top = 0; top < height; top += 32) {
+    int rows = height - top < 32 ? height - top : 32;
+    for (int word = 0; word < rowSize; word++) {
+      for (int k = 0; k < 32; k++) {
+        block[k] = k < rows ? (unsigned int)bits[(top + k) * rowSize + word] : 0;
+      }
+      transpose32(block);
+      int left = word << logBits;
+      int columns = width - left < 32 ? width - left : 32;
+      for (int k = 0; k < columns; k++) {
+        result->bits[(left + k) * resultRowSize + (top >> logBits)] = (int)block[k];
+      }
+    }
+  }
+  return result;
+}
+
+Ref<BitMatrix> BitMatrix::clone() const {
+  Ref<BitMatrix> result(new BitMatrix(width, height));
+  for (int i = 0, size = rowSize * height; i < size; i++) {
+    result->bits[i] = bits[i];
+  }
+  return result;
+}
+
+Ref<BitMatrix> BitMatrix::crop(int left, int top, int width, int height) const {
+  if (left < 0 || top < 0 || left + width > this->width || top + height > this->height) {
+    throw IllegalArgumentException("The region must fit inside the matrix");
+  }
+  Ref<BitMatrix> result(new BitMatrix(width, height));
+  int resultRowSize = result->rowSize;
+  int shift = left & bitsMask;
+  unsigned int lastWord = (width & bitsMask) != 0 ? (1u << (width & bitsMask)) - 1 : ~0u;
+  for (int y = 0; y < height; y++) {
+    int offset = (top + y) * rowSize + (left >> logBits);
+    int rowEnd = (top + y + 1) * rowSize;
+    for (int i = 0; i < resultRowSize; i++) {
+      unsigned int word = (unsigned int)bits[offset + i] >> shift;
+      if (shift != 0 && offset + i + 1 < rowEnd) {
+        word |= (unsigned int)bits[offset + i + 1] << (bitsPerWord - shift);
+      }
+      if (i == resultRowSize - 1) {
+        word &= lastWord;
+      }
+      result->bits[y * resultRowSize + i] = (int)word;
+    }
+  }
+  return result;
+}
+
+bool BitMatrix::equals(BitMatrix const& other) const {
+  if (width != other.width || height != other.height) {
+    return false;
+  }
+  for (int i = 0, size = rowSize * height; i < size; i++) {
+    if (bits[i] != other.bits[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int BitMatrix::hashCode() const {
+  unsigned int hash = width;
+  hash = 31 * hash + height;
+  for (int i = 0, size = rowSize * height; i < size; i++) {
+    hash = 31 * hash + (unsigned int)bits[i];
+  }
+  return (int)hash;
+}
+
 int BitMatrix::getWidth() const {
   return width;
 }
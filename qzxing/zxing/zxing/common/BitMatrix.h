@@ -69,6 +69,48 @@ public:
   void clear();
   void setRegion(int left, int top, int width, int height);
   Ref<BitArray> getRow(int y, Ref<BitArray> row);
+  void setRow(int y, Ref<BitArray> row);
+
+  /**
+   * Returns the index of the next set (black) or unset (white) bit in row y at
+   * or after x, or the width if there is none. Runs of one colour are skipped
+   * a whole word at a time.
+   */
+  int getNextSet(int x, int y) const;
+  int getNextUnset(int x, int y) const;
+
+  /**
+   * Returns how many times the colour changes between neighbouring bits of
+   * row y, from x to lastX inclusive. Counted a word at a time.
+   */
+  int countTransitions(int x, int lastX, int y) const;
+
+  /**
+   * Returns whether any bit is set in the rectangle from (left, top) to
+   * (right, bottom), edges included. Each row is tested a word at a time.
+   */
+  bool isAnySet(int left, int top, int right, int bottom) const;
+
+  /**
+   * Returns the first column from x on, stepping by step (1 or -1), whose bits
+   * from row top to row bottom are all unset, or the first column outside the
+   * matrix (the width or -1) if there is none. The rows' words are OR-ed
+   * together, so 32 columns are tested at once.
+   */
+  int getNextUnsetColumn(int x, int top, int bottom, int step) const;
+
+  /**
+   * Returns a new matrix with rows and columns swapped, so that a column of
+   * this matrix can be walked as a contiguous row. Built 32x32 bits at a time.
+   */
+  Ref<BitMatrix> transpose() const;
+
+  Ref<BitMatrix> clone() const;
+
+  /** Returns a copy of a rectangle of this matrix, shifted into place a word at a time. */
+  Ref<BitMatrix> crop(int left, int top, int width, int height) const;
+  bool equals(BitMatrix const& other) const;
+  int hashCode() const;
 
   int getWidth() const;
   int getHeight() const;
@@ -0,0 +1,76 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  DecoderResultCache.cpp
+ *  zxing
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/DecoderResultCache.h>
+
+using zxing::DecoderResultCache;
+using zxing::DecoderResult;
+using zxing::BitMatrix;
+using zxing::Ref;
+
+DecoderResultCache::DecoderResultCache(int capacity)
+  : capacity_(capacity > 0 ? capacity : 1) {
+}
+
+Ref<DecoderResult> DecoderResultCache::get(int tag, Ref<BitMatrix> const& bits) {
+  int hash = bits->hashCode();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (std::list<Entry>::iterator it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->tag == tag && it->hash == hash && it->bits->equals(*bits)) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return it->result;
+    }
+  }
+  return Ref<DecoderResult>();
+}
+
+void DecoderResultCache::put(int tag, Ref<BitMatrix> const& bits, Ref<DecoderResult> const& result) {
+  Entry entry;
+  entry.tag = tag;
+  entry.hash = bits->hashCode();
+  entry.bits = bits;
+  entry.result = result;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (std::list<Entry>::iterator it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->tag == tag && it->hash == entry.hash && it->bits->equals(*bits)) {
+      entries_.erase(it);
+      break;
+    }
+  }
+  entries_.push_front(entry);
+  while (entries_.size() > capacity_) {
+    entries_.pop_back();
+  }
+}
+
+int DecoderResultCache::getCapacity() const {
+  return (int)capacity_;
+}
+
+void DecoderResultCache::setCapacity(int capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity > 0 ? capacity : 1;
+  while (entries_.size() > capacity_) {
+    entries_.pop_back();
+  }
+}
+
+void DecoderResultCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+}
@@ -0,0 +1,70 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __DECODER_RESULT_CACHE_H__
+#define __DECODER_RESULT_CACHE_H__
+/*
+ *  DecoderResultCache.h
+ *  zxing
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <list>
+#include <mutex>
+#include <zxing/common/Counted.h>
+#include <zxing/common/BitMatrix.h>
+#include <zxing/common/DecoderResult.h>
+
+namespace zxing {
+
+/**
+ * Most recently decoded symbols, keyed by the module grid sampled by the
+ * detector. When the same symbol stays in front of the camera, every frame
+ * samples the same grid, and a hit skips error correction and the bit stream
+ * parsing. The tag tells apart grids that need decoding differently: the
+ * symbology, plus whatever else besides the bits the decoder depends on.
+ * Safe to share between readers running on different threads.
+ */
+class DecoderResultCache : public Counted {
+ private:
+  struct Entry {
+    int tag;
+    int hash;
+    Ref<BitMatrix> bits;
+    Ref<DecoderResult> result;
+  };
+
+  std::list<Entry> entries_;
+  size_t capacity_;
+  std::mutex mutex_;
+
+ public:
+  DecoderResultCache(int capacity = 8);
+
+  /** Returns the cached result for the grid, or an empty reference. */
+  Ref<DecoderResult> get(int tag, Ref<BitMatrix> const& bits);
+
+  /**
+   * Remembers the result decoded from the grid, dropping the least recently
+   * used entry when full. The grid must be the one sampled by the detector,
+   * taken before decoding: some decoders unmask the bits in place.
+   */
+  void put(int tag, Ref<BitMatrix> const& bits, Ref<DecoderResult> const& result);
+
+  int getCapacity() const;
+  void setCapacity(int capacity);
+  void clear();
+};
+
+}
+
+#endif // __DECODER_RESULT_CACHE_H__
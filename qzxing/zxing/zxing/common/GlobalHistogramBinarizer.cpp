@@ -21,6 +21,7 @@
 #include <zxing/common/GlobalHistogramBinarizer.h>
 #include <zxing/NotFoundException.h>
 #include <zxing/common/Array.h>
+#include <cstdlib>
 
 using zxing::GlobalHistogramBinarizer;
 using zxing::Binarizer;
@@ -36,6 +37,9 @@ namespace {
   const int LUMINANCE_BITS = 5;
   const int LUMINANCE_SHIFT = 8 - LUMINANCE_BITS;
   const int LUMINANCE_BUCKETS = 1 << LUMINANCE_BITS;
+  const int LIGHTING_SAMPLE_ROWS = 4;
+  const int LIGHTING_SAMPLE_COLUMNS = 4;
+  const int MAX_BLACK_POINT_SPREAD = 3 << LUMINANCE_SHIFT;
   const ArrayRef<char> EMPTY (0);
 }
 
@@ -207,6 +211,59 @@ int GlobalHistogramBinarizer::estimateBlackPoint(ArrayRef<int> const& buckets) {
   return bestValley << LUMINANCE_SHIFT;
 }
 
+/**
+ * Cheap check whether a single global threshold is good enough for the image,
+ * so that callers can skip local thresholding. The same rows that
+ * getBlackMatrix() samples are split into segments. The image qualifies when
+ * the whole sample is bimodal and every segment with enough contrast to have
+ * its own black point agrees with the global one. Segments without contrast,
+ * e.g. plain background, carry no information and are skipped.
+ */
+bool GlobalHistogramBinarizer::hasUniformLighting(Ref<LuminanceSource> const& source) {
+  int width = source->getWidth();
+  int height = source->getHeight();
+  int segmentWidth = width / LIGHTING_SAMPLE_COLUMNS;
+  if (segmentWidth < LUMINANCE_BUCKETS) {
+    return false;
+  }
+
+  ArrayRef<int> globalBuckets(LUMINANCE_BUCKETS);
+  ArrayRef<int> segmentBuckets(LUMINANCE_BUCKETS * LIGHTING_SAMPLE_ROWS * LIGHTING_SAMPLE_COLUMNS);
+  ArrayRef<char> row(width);
+  for (int y = 0; y < LIGHTING_SAMPLE_ROWS; y++) {
+    ArrayRef<char> luminances = source->getRow(height * (y + 1) / (LIGHTING_SAMPLE_ROWS + 1), row);
+    for (int x = 0; x < segmentWidth * LIGHTING_SAMPLE_COLUMNS; x++) {
+      int bucket = (luminances[x] & 0xff) >> LUMINANCE_SHIFT;
+      int segment = y * LIGHTING_SAMPLE_COLUMNS + x / segmentWidth;
+      globalBuckets[bucket]++;
+      segmentBuckets[segment * LUMINANCE_BUCKETS + bucket]++;
+    }
+  }
+
+  int blackPoint;
+  try {
+    blackPoint = estimateBlackPoint(globalBuckets);
+  } catch (NotFoundException const&) {
+    return false;
+  }
+
+  ArrayRef<int> buckets(LUMINANCE_BUCKETS);
+  for (int segment = 0; segment < LIGHTING_SAMPLE_ROWS * LIGHTING_SAMPLE_COLUMNS; segment++) {
+    for (int x = 0; x < LUMINANCE_BUCKETS; x++) {
+      buckets[x] = segmentBuckets[segment * LUMINANCE_BUCKETS + x];
+    }
+    try {
+      int segmentBlackPoint = estimateBlackPoint(buckets);
+      if (abs(segmentBlackPoint - blackPoint) > MAX_BLACK_POINT_SPREAD) {
+        return false;
+      }
+    } catch (NotFoundException const&) {
+      // no contrast in this segment
+    }
+  }
+  return true;
+}
+
 Ref<Binarizer> GlobalHistogramBinarizer::createBinarizer(Ref<LuminanceSource> source) {
   return Ref<Binarizer> (new GlobalHistogramBinarizer(source));
 }
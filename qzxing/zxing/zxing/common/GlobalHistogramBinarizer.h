@@ -38,6 +38,7 @@ public:
   virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
   virtual Ref<BitMatrix> getBlackMatrix();
   static int estimateBlackPoint(ArrayRef<int> const& buckets);
+  static bool hasUniformLighting(Ref<LuminanceSource> const& source);
   Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
 private:
   void initArrays(int luminanceSize);
@@ -69,6 +69,16 @@ ArrayRef<char> GreyscaleLuminanceSource::getMatrix() const {
   return result;
 }
 
+Ref<LuminanceSource> GreyscaleLuminanceSource::crop(int left, int top, int width, int height) const {
+  if (left < 0 || top < 0 || left + width > getWidth() || top + height > getHeight()) {
+    throw IllegalArgumentException("Crop rectangle does not fit within image data.");
+  }
+  // Another window onto the same data, nothing is copied
+  return Ref<LuminanceSource>(
+      new GreyscaleLuminanceSource(greyData_, dataWidth_, dataHeight_,
+                                   left_ + left, top_ + top, width, height));
+}
+
 Ref<LuminanceSource> GreyscaleLuminanceSource::rotateCounterClockwise() const {
   // Intentionally flip the left, top, width, and height arguments as
   // needed. dataWidth and dataHeight are always kept unrotated.
@@ -46,6 +46,12 @@ public:
   }
 
   Ref<LuminanceSource> rotateCounterClockwise() const;
+
+  bool isCropSupported() const {
+    return true;
+  }
+
+  Ref<LuminanceSource> crop(int left, int top, int width, int height) const;
 };
 
 }
@@ -21,6 +21,7 @@
 #include <zxing/common/HybridBinarizer.h>
 
 #include <zxing/common/IllegalArgumentException.h>
+#include <cstdlib>
 
 using namespace std;
 using namespace zxing;
@@ -30,10 +31,47 @@ namespace {
   const int BLOCK_SIZE = 1 << BLOCK_SIZE_POWER; // ...0100...00
   const int BLOCK_SIZE_MASK = BLOCK_SIZE - 1;   // ...0011...11
   const int MINIMUM_DIMENSION = BLOCK_SIZE * 5;
+  const int NO_SIGNATURE = -1;
+}
+
+BlackPointCache::BlackPointCache(int tolerance) :
+  lastEntry_(0), tolerance_(tolerance) {
+}
+
+int BlackPointCache::getTolerance() const {
+  return tolerance_;
+}
+
+void BlackPointCache::setTolerance(int tolerance) {
+  tolerance_ = tolerance;
+}
+
+void BlackPointCache::clear() {
+  for (int i = 0; i < MAX_ENTRIES; i++) {
+    entries_[i].signatures.assign(entries_[i].signatures.size(), NO_SIGNATURE);
+  }
+}
+
+BlackPointCache::Entry *BlackPointCache::select(int width, int height, int blocks) {
+  for (int i = 0; i < MAX_ENTRIES; i++) {
+    if (entries_[i].width == width && entries_[i].height == height) {
+      lastEntry_ = i;
+      return &entries_[i];
+    }
+  }
+  // Replace the entry that was not used last
+  lastEntry_ = (lastEntry_ + 1) % MAX_ENTRIES;
+  Entry &entry = entries_[lastEntry_];
+  entry.width = width;
+  entry.height = height;
+  entry.blackPoints.assign(blocks, 0);
+  entry.signatures.assign(blocks, NO_SIGNATURE);
+  return &entry;
 }
 
 HybridBinarizer::HybridBinarizer(Ref<LuminanceSource> source) :
-  GlobalHistogramBinarizer(source), matrix_(NULL), cached_row_(NULL) {
+  GlobalHistogramBinarizer(source), matrix_(NULL), subWidth_(0), subHeight_(0),
+  blackPointRows_(0), localBlackRows_(false) {
 }
 
 HybridBinarizer::~HybridBinarizer() {
@@ -42,9 +80,96 @@ HybridBinarizer::~HybridBinarizer() {
 
 Ref<Binarizer>
 HybridBinarizer::createBinarizer(Ref<LuminanceSource> source) {
-  return Ref<Binarizer> (new HybridBinarizer(source));
+  HybridBinarizer *binarizer = new HybridBinarizer(source);
+  binarizer->setLocalBlackRows(localBlackRows_);
+  binarizer->setBlackPointCache(blackPointCache_);
+  return Ref<Binarizer> (binarizer);
+}
+
+void HybridBinarizer::setLocalBlackRows(bool enabled) {
+  localBlackRows_ = enabled;
+}
+
+bool HybridBinarizer::getLocalBlackRows() const {
+  return localBlackRows_;
+}
+
+void HybridBinarizer::setBlackPointCache(Ref<BlackPointCache> cache) {
+  blackPointCache_ = cache;
+}
+
+Ref<BlackPointCache> HybridBinarizer::getBlackPointCache() const {
+  return blackPointCache_;
 }
 
+void HybridBinarizer::initBlackPoints(int width, int height) {
+  if (blackPoints_) {
+    return;
+  }
+  luminances_ = getLuminanceSource()->getMatrix();
+  subWidth_ = width >> BLOCK_SIZE_POWER;
+  if ((width & BLOCK_SIZE_MASK) != 0) {
+    subWidth_++;
+  }
+  subHeight_ = height >> BLOCK_SIZE_POWER;
+  if ((height & BLOCK_SIZE_MASK) != 0) {
+    subHeight_++;
+  }
+  blackPoints_ = ArrayRef<int>(subHeight_ * subWidth_);
+  blackPointRows_ = 0;
+}
+
+namespace {
+  inline int cap(int value, int min, int max) {
+    return value < min ? min : value > max ? max : value;
+  }
+
+  // Average of the 5x5 block neighbourhood around (x, y), clamped to the grid.
+  inline int averageBlackPoint(ArrayRef<int> const& blackPoints,
+                               int subWidth, int subHeight, int x, int y) {
+    int left = cap(x, 2, subWidth - 3);
+    int top = cap(y, 2, subHeight - 3);
+    int sum = 0;
+    for (int z = -2; z <= 2; z++) {
+      const int *blackRow = &blackPoints[(top + z) * subWidth];
+      sum += blackRow[left - 2];
+      sum += blackRow[left - 1];
+      sum += blackRow[left];
+      sum += blackRow[left + 1];
+      sum += blackRow[left + 2];
+    }
+    return sum / 25;
+  }
+}
+
+Ref<BitArray> HybridBinarizer::getBlackRow(int y, Ref<BitArray> row) {
+  if (!localBlackRows_) {
+    return GlobalHistogramBinarizer::getBlackRow(y, row);
+  }
+  if (matrix_) {
+    return matrix_->getRow(y, row);
+  }
+  LuminanceSource& source = *getLuminanceSource();
+  int width = source.getWidth();
+  int height = source.getHeight();
+  if (width < MINIMUM_DIMENSION || height < MINIMUM_DIMENSION) {
+    return GlobalHistogramBinarizer::getBlackRow(y, row);
+  }
+  if (row == NULL || static_cast<int>(row->getSize()) < width) {
+    row = new BitArray(width);
+  } else {
+    row->clear();
+  }
+  initBlackPoints(width, height);
+  // Block rows are computed top-down as low contrast blocks borrow from their
+  // upper neighbours, so only the part of the grid above this row is needed.
+  int blockRow = y >> BLOCK_SIZE_POWER;
+  int last = cap(blockRow + 1, 0, subHeight_ - 1);
+  calculateBlackPoints(luminances_, subWidth_, subHeight_, width, height,
+                       cap(last, 2, subHeight_ - 3) + 3);
+  thresholdRow(luminances_, y, width, height, row);
+  return row;
+}
 
 /**
  * Calculates the final BitMatrix once for all requests. This could be called once from the
@@ -59,25 +184,16 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
   int width = source.getWidth();
   int height = source.getHeight();
   if (width >= MINIMUM_DIMENSION && height >= MINIMUM_DIMENSION) {
-    ArrayRef<char> luminances = source.getMatrix();
-    int subWidth = width >> BLOCK_SIZE_POWER;
-    if ((width & BLOCK_SIZE_MASK) != 0) {
-      subWidth++;
-    }
-    int subHeight = height >> BLOCK_SIZE_POWER;
-    if ((height & BLOCK_SIZE_MASK) != 0) {
-      subHeight++;
-    }
-    ArrayRef<int> blackPoints =
-      calculateBlackPoints(luminances, subWidth, subHeight, width, height);
+    initBlackPoints(width, height);
+    calculateBlackPoints(luminances_, subWidth_, subHeight_, width, height, subHeight_);
 
     Ref<BitMatrix> newMatrix (new BitMatrix(width, height));
-    calculateThresholdForBlock(luminances,
-                               subWidth,
-                               subHeight,
+    calculateThresholdForBlock(luminances_,
+                               subWidth_,
+                               subHeight_,
                                width,
                                height,
-                               blackPoints,
+                               blackPoints_,
                                newMatrix);
     matrix_ = newMatrix;
   } else {
@@ -87,12 +203,6 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
   return matrix_;
 }
 
-namespace {
-  inline int cap(int value, int min, int max) {
-    return value < min ? min : value > max ? max : value;
-  }
-}
-
 void
 HybridBinarizer::calculateThresholdForBlock(ArrayRef<char> luminances,
                                             int subWidth,
@@ -113,23 +223,51 @@ HybridBinarizer::calculateThresholdForBlock(ArrayRef<char> luminances,
       if (xoffset > maxXOffset) {
         xoffset = maxXOffset;
       }
-      int left = cap(x, 2, subWidth - 3);
-      int top = cap(y, 2, subHeight - 3);
-      int sum = 0;
-      for (int z = -2; z <= 2; z++) {
-        int *blackRow = &blackPoints[(top + z) * subWidth];
-        sum += blackRow[left - 2];
-        sum += blackRow[left - 1];
-        sum += blackRow[left];
-        sum += blackRow[left + 1];
-        sum += blackRow[left + 2];
-      }
-      int average = sum / 25;
+      int average = averageBlackPoint(blackPoints, subWidth, subHeight, x, y);
       thresholdBlock(luminances, xoffset, yoffset, average, width, matrix);
     }
   }
 }
 
+/**
+ * Thresholds a single image row exactly as calculateThresholdForBlock would,
+ * including the overlap of the last, clamped, block row and column.
+ */
+void HybridBinarizer::thresholdRow(ArrayRef<char> luminances,
+                                   int y,
+                                   int width,
+                                   int height,
+                                   Ref<BitArray> const& row) {
+  int blockRow = y >> BLOCK_SIZE_POWER;
+  int maxYOffset = height - BLOCK_SIZE;
+  int maxXOffset = width - BLOCK_SIZE;
+  for (int by = blockRow - 1; by <= blockRow + 1; by++) {
+    if (by < 0 || by >= subHeight_) {
+      continue;
+    }
+    int yoffset = by << BLOCK_SIZE_POWER;
+    if (yoffset > maxYOffset) {
+      yoffset = maxYOffset;
+    }
+    if (y < yoffset || y >= yoffset + BLOCK_SIZE) {
+      continue;
+    }
+    const char *pixels = &luminances[y * width];
+    for (int x = 0; x < subWidth_; x++) {
+      int xoffset = x << BLOCK_SIZE_POWER;
+      if (xoffset > maxXOffset) {
+        xoffset = maxXOffset;
+      }
+      int threshold = averageBlackPoint(blackPoints_, subWidth_, subHeight_, x, by);
+      for (int xx = 0; xx < BLOCK_SIZE; xx++) {
+        if ((pixels[xoffset + xx] & 0xff) <= threshold) {
+          row->set(xoffset + xx);
+        }
+      }
+    }
+  }
+}
+
 void HybridBinarizer::thresholdBlock(ArrayRef<char> luminances,
                                      int xoffset,
                                      int yoffset,
@@ -154,18 +292,37 @@ namespace {
             2*blackPoints[y*subWidth+x-1] +
             blackPoints[(y-1)*subWidth+x-1]) >> 2;
   }
+
+  // Sum of the block diagonal, one pixel from every row and column.
+  inline int blockSignature(const char *pixels, int stride) {
+    int sum = 0;
+    for (int i = 0; i < BLOCK_SIZE; i++, pixels += stride + 1) {
+      sum += *pixels & 0xFF;
+    }
+    return sum;
+  }
 }
 
 
-ArrayRef<int> HybridBinarizer::calculateBlackPoints(ArrayRef<char> luminances,
-                                                    int subWidth,
-                                                    int subHeight,
-                                                    int width,
-                                                    int height) {
+void HybridBinarizer::calculateBlackPoints(ArrayRef<char> luminances,
+                                           int subWidth,
+                                           int subHeight,
+                                           int width,
+                                           int height,
+                                           int toRow) {
   const int minDynamicRange = 24;
 
-  ArrayRef<int> blackPoints (subHeight * subWidth);
-  for (int y = 0; y < subHeight; y++) {
+  ArrayRef<int> blackPoints = blackPoints_;
+  BlackPointCache::Entry *cache = NULL;
+  int tolerance = 0;
+  if (blackPointCache_) {
+    cache = blackPointCache_->select(width, height, subHeight * subWidth);
+    tolerance = blackPointCache_->tolerance_;
+  }
+  if (toRow > subHeight) {
+    toRow = subHeight;
+  }
+  for (int y = blackPointRows_; y < toRow; y++) {
     int yoffset = y << BLOCK_SIZE_POWER;
     int maxYOffset = height - BLOCK_SIZE;
     if (yoffset > maxYOffset) {
@@ -177,6 +334,15 @@ ArrayRef<int> HybridBinarizer::calculateBlackPoints(ArrayRef<char> luminances,
       if (xoffset > maxXOffset) {
         xoffset = maxXOffset;
       }
+      int signature = 0;
+      if (cache) {
+        int &cached = cache->signatures[y * subWidth + x];
+        signature = blockSignature(&luminances[yoffset * width + xoffset], width);
+        if (cached != NO_SIGNATURE && abs(signature - cached) <= tolerance) {
+          blackPoints[y * subWidth + x] = cache->blackPoints[y * subWidth + x];
+          continue;
+        }
+      }
       int sum = 0;
       int min = 0xFF;
       int max = 0;
@@ -219,8 +385,14 @@ ArrayRef<int> HybridBinarizer::calculateBlackPoints(ArrayRef<char> luminances,
         }
       }
       blackPoints[y * subWidth + x] = average;
+      if (cache) {
+        cache->blackPoints[y * subWidth + x] = average;
+        cache->signatures[y * subWidth + x] = signature;
+      }
     }
   }
-  return blackPoints;
+  if (toRow > blackPointRows_) {
+    blackPointRows_ = toRow;
+  }
 }
 
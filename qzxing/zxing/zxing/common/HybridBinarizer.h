@@ -27,26 +27,88 @@
 #include <zxing/common/BitMatrix.h>
 
 namespace zxing {
-	
+
+  /**
+   * Block black points kept between consecutive frames of a video stream.
+   * Each block remembers a cheap signature of the pixels its black point was
+   * computed from; while the signature stays within the tolerance the old
+   * black point is reused instead of being recomputed. Entries are kept per
+   * image size, so the normal and the rotated frame each have their own. Not
+   * thread safe, a cache must only be used by one HybridBinarizer at a time.
+   */
+  class BlackPointCache : public Counted {
+  private:
+    struct Entry {
+      int width;
+      int height;
+      std::vector<int> blackPoints;
+      std::vector<int> signatures;
+      Entry() : width(0), height(0) {}
+    };
+    static const int MAX_ENTRIES = 2;
+
+    Entry entries_[MAX_ENTRIES];
+    int lastEntry_;
+    int tolerance_;
+
+  public:
+    BlackPointCache(int tolerance = 16);
+
+    int getTolerance() const;
+    void setTolerance(int tolerance);
+    void clear();
+
+  private:
+    Entry *select(int width, int height, int blocks);
+    friend class HybridBinarizer;
+  };
+
 	class HybridBinarizer : public GlobalHistogramBinarizer {
 	 private:
     Ref<BitMatrix> matrix_;
-	  Ref<BitArray> cached_row_;
+    ArrayRef<char> luminances_;
+    ArrayRef<int> blackPoints_;
+    int subWidth_;
+    int subHeight_;
+    int blackPointRows_;
+    bool localBlackRows_;
+    Ref<BlackPointCache> blackPointCache_;
 
 	public:
 		HybridBinarizer(Ref<LuminanceSource> source);
 		virtual ~HybridBinarizer();
 		
+		virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
 		virtual Ref<BitMatrix> getBlackMatrix();
 		Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+
+    /**
+     * When enabled, getBlackRow() uses the same local block thresholds as
+     * getBlackMatrix() instead of a per-row histogram. Rows are sliced from
+     * the black matrix if it has already been built, otherwise only the
+     * block rows needed for the requested row are evaluated, and those are
+     * reused when the matrix is built later. Off by default.
+     */
+    void setLocalBlackRows(bool enabled);
+    bool getLocalBlackRows() const;
+
+    /**
+     * Reuses the block black points of the previous frame for blocks whose
+     * content did not change. Pass the same cache to the binarizer of each
+     * frame; a NULL cache disables the reuse, which is the default.
+     */
+    void setBlackPointCache(Ref<BlackPointCache> cache);
+    Ref<BlackPointCache> getBlackPointCache() const;
   private:
+    void initBlackPoints(int width, int height);
     // We'll be using one-D arrays because C++ can't dynamically allocate 2D
     // arrays
-    ArrayRef<int> calculateBlackPoints(ArrayRef<char> luminances,
-                                       int subWidth,
-                                       int subHeight,
-                                       int width,
-                                       int height);
+    void calculateBlackPoints(ArrayRef<char> luminances,
+                              int subWidth,
+                              int subHeight,
+                              int width,
+                              int height,
+                              int toRow);
     void calculateThresholdForBlock(ArrayRef<char> luminances,
                                     int subWidth,
                                     int subHeight,
@@ -54,6 +116,11 @@ namespace zxing {
                                     int height,
                                     ArrayRef<int> blackPoints,
                                     Ref<BitMatrix> const& matrix);
+    void thresholdRow(ArrayRef<char> luminances,
+                      int y,
+                      int width,
+                      int height,
+                      Ref<BitArray> const& row);
     void thresholdBlock(ArrayRef<char>luminances,
                         int xoffset,
                         int yoffset,
@@ -18,6 +18,8 @@
 
 #include <zxing/common/StringUtils.h>
 #include <zxing/DecodeHints.h>
+#include <cstring>
+#include <stdint.h>
 
 using namespace std;
 using namespace zxing;
@@ -70,7 +72,13 @@ StringUtils::guessEncoding(char* bytes, int length,
     bytes[1] == (byte) 0xBB &&
     bytes[2] == (byte) 0xBF;
 
-  for (int i = 0;
+  // 7-bit bytes leave all of the state below as it started
+  int start = asciiPrefixLength(bytes, length);
+  if (length > 0 && start == length) {
+    return ISO88591;
+  }
+
+  for (int i = start;
        i < length && (canBeISO88591 || canBeShiftJIS || canBeUTF8);
        i++) {
 
@@ -196,3 +204,74 @@ StringUtils::guessEncoding(char* bytes, int length,
   // Otherwise, we take a wild guess with platform encoding
   return PLATFORM_DEFAULT_ENCODING;
 }
+
+int StringUtils::asciiPrefixLength(char const* bytes, int length) {
+  int i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint64_t word;
+    memcpy(&word, bytes + i, 8);
+    if ((word & 0x8080808080808080ULL) != 0) {
+      break;
+    }
+  }
+  while (i < length && (bytes[i] & 0x80) == 0) {
+    i++;
+  }
+  return i;
+}
+
+bool StringUtils::isValidUTF8(char const* bytes, int length) {
+  int i = asciiPrefixLength(bytes, length);
+  while (i < length) {
+    int value = bytes[i] & 0xFF;
+    if (value < 0x80) {
+      i++;
+      continue;
+    }
+    int trailing;
+    int min;
+    if ((value & 0xE0) == 0xC0) {
+      trailing = 1;
+      min = 0x80;
+      value &= 0x1F;
+    } else if ((value & 0xF0) == 0xE0) {
+      trailing = 2;
+      min = 0x800;
+      value &= 0x0F;
+    } else if ((value & 0xF8) == 0xF0) {
+      trailing = 3;
+      min = 0x10000;
+      value &= 0x07;
+    } else {
+      return false;
+    }
+    if (i + trailing >= length) {
+      return false;
+    }
+    for (int j = 1; j <= trailing; j++) {
+      int next = bytes[i + j] & 0xFF;
+      if ((next & 0xC0) != 0x80) {
+        return false;
+      }
+      value = (value << 6) | (next & 0x3F);
+    }
+    if (value < min || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
+      return false;
+    }
+    i += trailing + 1;
+  }
+  return true;
+}
+
+bool StringUtils::isAsciiCompatible(char const* encoding) {
+  static char const* const prefixes[] = {
+    "ISO8859", "ISO-8859", "UTF8", "UTF-8", "ASCII", "US-ASCII",
+    "Cp437", "Cp125", "windows-125", "GB", "EUC", "Big5", 0
+  };
+  for (char const* const* prefix = prefixes; *prefix; prefix++) {
+    if (strncmp(encoding, *prefix, strlen(*prefix)) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
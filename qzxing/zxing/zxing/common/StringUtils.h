@@ -44,6 +44,15 @@ public:
   typedef std::map<DecodeHintType, std::string> Hashtable;
 
   static std::string guessEncoding(char* bytes, int length, Hashtable const& hints);
+
+  /** Returns the length of the leading run of 7-bit bytes, checked a word at a time. */
+  static int asciiPrefixLength(char const* bytes, int length);
+
+  /** Returns whether the bytes are well-formed UTF-8, without overlong forms or surrogates. */
+  static bool isValidUTF8(char const* bytes, int length);
+
+  /** Returns whether the encoding is known to map the bytes 0x00 to 0x7F to ASCII. */
+  static bool isAsciiCompatible(char const* encoding);
 };
 
 }
@@ -95,13 +95,10 @@ std::vector<Ref<ResultPoint> > WhiteRectangleDetector::detect() {
     // .....
     // .   |
     // .....
-    bool rightBorderNotWhite = true;
-    while (rightBorderNotWhite && right < width_) {
-      rightBorderNotWhite = containsBlackPoint(up, down, right, false);
-      if (rightBorderNotWhite) {
-        right++;
-        aBlackPointFoundOnBorder = true;
-      }
+    int whiteRight = image_->getNextUnsetColumn(right, up, down, 1);
+    if (whiteRight != right) {
+      right = whiteRight;
+      aBlackPointFoundOnBorder = true;
     }
 
     if (right >= width_) {
@@ -129,13 +126,10 @@ std::vector<Ref<ResultPoint> > WhiteRectangleDetector::detect() {
     // .....
     // |   .
     // .....
-    bool leftBorderNotWhite = true;
-    while (leftBorderNotWhite && left >= 0) {
-      leftBorderNotWhite = containsBlackPoint(up, down, left, false);
-      if (leftBorderNotWhite) {
-        left--;
-        aBlackPointFoundOnBorder = true;
-      }
+    int whiteLeft = image_->getNextUnsetColumn(left, up, down, -1);
+    if (whiteLeft != left) {
+      left = whiteLeft;
+      aBlackPointFoundOnBorder = true;
     }
 
     if (left < 0) {
@@ -313,18 +307,7 @@ vector<Ref<ResultPoint> > WhiteRectangleDetector::centerEdges(Ref<ResultPoint> y
  */
 bool WhiteRectangleDetector::containsBlackPoint(int a, int b, int fixed, bool horizontal) {
   if (horizontal) {
-    for (int x = a; x <= b; x++) {
-      if (image_->get(x, fixed)) {
-        return true;
-      }
-    }
-  } else {
-    for (int y = a; y <= b; y++) {
-      if (image_->get(fixed, y)) {
-        return true;
-      }
-    }
+    return image_->isAnySet(a, fixed, b, fixed);
   }
-
-  return false;
+  return image_->isAnySet(fixed, a, fixed, b);
 }
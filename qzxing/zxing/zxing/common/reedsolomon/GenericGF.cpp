@@ -38,7 +38,9 @@ Ref<GenericGF> GenericGF::AZTEC_DATA_8 = DATA_MATRIX_FIELD_256;
 Ref<GenericGF> GenericGF::MAXICODE_FIELD_64 = AZTEC_DATA_6;
   
 namespace {
-  int INITIALIZATION_THRESHOLD = 0;
+  // The shared fields are built up front: a lazy initialize() would race when
+  // several symbols are decoded on different threads at once.
+  const int INITIALIZATION_THRESHOLD = 4096;
 }
   
 GenericGF::GenericGF(int primitive_, int size_, int b)
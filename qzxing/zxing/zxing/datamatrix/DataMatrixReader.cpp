@@ -33,13 +33,21 @@ DataMatrixReader::DataMatrixReader() :
 }
 
 Ref<Result> DataMatrixReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
-  (void)hints;
   Detector detector(image->getBlackMatrix());
   Ref<DetectorResult> detectorResult(detector.detect());
   ArrayRef< Ref<ResultPoint> > points(detectorResult->getPoints());
 
-
-  Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult->getBits()));
+  Ref<DecoderResultCache> cache(hints.getDecoderResultCache());
+  Ref<DecoderResult> decoderResult;
+  if (cache) {
+    decoderResult = cache->get(BarcodeFormat::DATA_MATRIX, detectorResult->getBits());
+  }
+  if (!decoderResult) {
+    decoderResult = decoder_.decode(detectorResult->getBits());
+    if (cache) {
+      cache->put(BarcodeFormat::DATA_MATRIX, detectorResult->getBits(), decoderResult);
+    }
+  }
 
   Ref<Result> result(
     new Result(decoderResult->getText(), decoderResult->getRawBytes(), points, BarcodeFormat::DATA_MATRIX));
@@ -19,181 +19,160 @@
  */
 
 #include <zxing/datamatrix/Version.h>
-#include <limits>
-#include <iostream>
 
 namespace zxing {
 namespace datamatrix {
 using namespace std;
 
-ECB::ECB(int count, int dataCodewords) :
-    count_(count), dataCodewords_(dataCodewords) {
-}
-
-int ECB::getCount() {
+int ECB::getCount() const {
   return count_;
 }
 
-int ECB::getDataCodewords() {
+int ECB::getDataCodewords() const {
   return dataCodewords_;
 }
 
-ECBlocks::ECBlocks(int ecCodewords, ECB *ecBlocks) :
-    ecCodewords_(ecCodewords), ecBlocks_(1, ecBlocks) {
-}
-
-ECBlocks::ECBlocks(int ecCodewords, ECB *ecBlocks1, ECB *ecBlocks2) :
-    ecCodewords_(ecCodewords), ecBlocks_(1, ecBlocks1) {
-  ecBlocks_.push_back(ecBlocks2);
-}
-
-int ECBlocks::getECCodewords() {
+int ECBlocks::getECCodewords() const {
   return ecCodewords_;
 }
 
-std::vector<ECB*>& ECBlocks::getECBlocks() {
-  return ecBlocks_;
-}
-
-ECBlocks::~ECBlocks() {
-  for (size_t i = 0; i < ecBlocks_.size(); i++) {
-    delete ecBlocks_[i];
-  }
+int ECBlocks::getNumECBlocks() const {
+  return numECBlocks_;
 }
 
-vector<Ref<Version> > Version::VERSIONS;
-static int N_VERSIONS = Version::buildVersions();
-
-Version::Version(int versionNumber, int symbolSizeRows, int symbolSizeColumns, int dataRegionSizeRows,
-		int dataRegionSizeColumns, ECBlocks* ecBlocks) : versionNumber_(versionNumber), 
-		symbolSizeRows_(symbolSizeRows), symbolSizeColumns_(symbolSizeColumns), 
-		dataRegionSizeRows_(dataRegionSizeRows), dataRegionSizeColumns_(dataRegionSizeColumns), 
-		ecBlocks_(ecBlocks), totalCodewords_(0) {
-    // Calculate the total number of codewords
-    int total = 0;
-    int ecCodewords = ecBlocks_->getECCodewords();
-    vector<ECB*> &ecbArray = ecBlocks_->getECBlocks();
-    for (unsigned int i = 0; i < ecbArray.size(); i++) {
-      ECB *ecBlock = ecbArray[i];
-      total += ecBlock->getCount() * (ecBlock->getDataCodewords() + ecCodewords);
-    }
-    totalCodewords_ = total;
+const ECB &ECBlocks::getECBlock(int i) const {
+  return ecBlocks_[i];
 }
 
-Version::~Version() {
-    delete ecBlocks_;
-}
-
-int Version::getVersionNumber() {
+/**
+ * See ISO 16022:2006 5.5.1 Table 7
+ */
+const Version Version::VERSIONS[] = {
+  Version(1, 10, 10, 8, 8,
+          ECBlocks(5, ECB(1, 3))),
+  Version(2, 12, 12, 10, 10,
+          ECBlocks(7, ECB(1, 5))),
+  Version(3, 14, 14, 12, 12,
+          ECBlocks(10, ECB(1, 8))),
+  Version(4, 16, 16, 14, 14,
+          ECBlocks(12, ECB(1, 12))),
+  Version(5, 18, 18, 16, 16,
+          ECBlocks(14, ECB(1, 18))),
+  Version(6, 20, 20, 18, 18,
+          ECBlocks(18, ECB(1, 22))),
+  Version(7, 22, 22, 20, 20,
+          ECBlocks(20, ECB(1, 30))),
+  Version(8, 24, 24, 22, 22,
+          ECBlocks(24, ECB(1, 36))),
+  Version(9, 26, 26, 24, 24,
+          ECBlocks(28, ECB(1, 44))),
+  Version(10, 32, 32, 14, 14,
+          ECBlocks(36, ECB(1, 62))),
+  Version(11, 36, 36, 16, 16,
+          ECBlocks(42, ECB(1, 86))),
+  Version(12, 40, 40, 18, 18,
+          ECBlocks(48, ECB(1, 114))),
+  Version(13, 44, 44, 20, 20,
+          ECBlocks(56, ECB(1, 144))),
+  Version(14, 48, 48, 22, 22,
+          ECBlocks(68, ECB(1, 174))),
+  Version(15, 52, 52, 24, 24,
+          ECBlocks(42, ECB(2, 102))),
+  Version(16, 64, 64, 14, 14,
+          ECBlocks(56, ECB(2, 140))),
+  Version(17, 72, 72, 16, 16,
+          ECBlocks(36, ECB(4, 92))),
+  Version(18, 80, 80, 18, 18,
+          ECBlocks(48, ECB(4, 114))),
+  Version(19, 88, 88, 20, 20,
+          ECBlocks(56, ECB(4, 144))),
+  Version(20, 96, 96, 22, 22,
+          ECBlocks(68, ECB(4, 174))),
+  Version(21, 104, 104, 24, 24,
+          ECBlocks(56, ECB(6, 136))),
+  Version(22, 120, 120, 18, 18,
+          ECBlocks(68, ECB(6, 175))),
+  Version(23, 132, 132, 20, 20,
+          ECBlocks(62, ECB(8, 163))),
+  Version(24, 144, 144, 22, 22,
+          ECBlocks(62, ECB(8, 156), ECB(2, 155))),
+  Version(25, 8, 18, 6, 16,
+          ECBlocks(7, ECB(1, 5))),
+  Version(26, 8, 32, 6, 14,
+          ECBlocks(11, ECB(1, 10))),
+  Version(27, 12, 26, 10, 24,
+          ECBlocks(14, ECB(1, 16))),
+  Version(28, 12, 36, 10, 16,
+          ECBlocks(18, ECB(1, 22))),
+  Version(29, 16, 36, 14, 16,
+          ECBlocks(24, ECB(1, 32))),
+  Version(30, 16, 48, 14, 22,
+          ECBlocks(28, ECB(1, 49)))
+};
+const int Version::N_VERSIONS = sizeof(VERSIONS) / sizeof(VERSIONS[0]);
+
+// The square versions come first; the rest are rectangular
+static const int FIRST_RECTANGULAR_VERSION = 25;
+// Number of the square version with 2 * i rows, 0 if there is none
+static const int SQUARE_VERSION_FOR_HALF_SIZE[] = {
+  0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7,
+  8, 9, 0, 0, 10, 0, 11, 0, 12, 0, 13, 0,
+  14, 0, 15, 0, 0, 0, 0, 0, 16, 0, 0, 0,
+  17, 0, 0, 0, 18, 0, 0, 0, 19, 0, 0, 0,
+  20, 0, 0, 0, 21, 0, 0, 0, 0, 0, 0, 0,
+  22, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0,
+  24
+};
+static const int MAX_SQUARE_HALF_SIZE = sizeof(SQUARE_VERSION_FOR_HALF_SIZE) / sizeof(SQUARE_VERSION_FOR_HALF_SIZE[0]) - 1;
+
+int Version::getVersionNumber() const {
   return versionNumber_;
 }
 
-int Version::getSymbolSizeRows() {
+int Version::getSymbolSizeRows() const {
   return symbolSizeRows_;
 }
   
-int Version::getSymbolSizeColumns() {
+int Version::getSymbolSizeColumns() const {
   return symbolSizeColumns_;
 }
 
-int Version::getDataRegionSizeRows() {
+int Version::getDataRegionSizeRows() const {
   return dataRegionSizeRows_;
 }
   
-int Version::getDataRegionSizeColumns() {
+int Version::getDataRegionSizeColumns() const {
   return dataRegionSizeColumns_;
 }
   
-int Version::getTotalCodewords() {
+int Version::getTotalCodewords() const {
   return totalCodewords_;
 }
 
-ECBlocks* Version::getECBlocks() {
+const ECBlocks &Version::getECBlocks() const {
   return ecBlocks_;
 }
   
-Ref<Version> Version::getVersionForDimensions(int numRows, int numColumns) {
+const Version *Version::getVersionForDimensions(int numRows, int numColumns) {
     if ((numRows & 0x01) != 0 || (numColumns & 0x01) != 0) {
       throw ReaderException("Number of rows and columns must be even");
     }
     
-    // TODO(bbrown): This is doing a linear search through the array of versions.
-    // If we interleave the rectangular versions with the square versions we could
-    // do a binary search.
-    for (int i = 0; i < N_VERSIONS; ++i){
-      Ref<Version> version(VERSIONS[i]);
-      if (version->getSymbolSizeRows() == numRows && version->getSymbolSizeColumns() == numColumns) {
-        return version;
+    if (numRows == numColumns) {
+      int half = numRows >> 1;
+      if (half >= 0 && half <= MAX_SQUARE_HALF_SIZE && SQUARE_VERSION_FOR_HALF_SIZE[half] != 0) {
+        return &VERSIONS[SQUARE_VERSION_FOR_HALF_SIZE[half] - 1];
+      }
+    } else {
+      // Only six rectangular versions, a scan is as quick as any index
+      for (int i = FIRST_RECTANGULAR_VERSION - 1; i < N_VERSIONS; ++i) {
+        const Version *version = &VERSIONS[i];
+        if (version->getSymbolSizeRows() == numRows && version->getSymbolSizeColumns() == numColumns) {
+          return version;
+        }
       }
     }
     throw ReaderException("Error version not found");
   }
-
-/**
- * See ISO 16022:2006 5.5.1 Table 7
- */
-int Version::buildVersions() {
-  VERSIONS.push_back(Ref<Version>(new Version(1, 10, 10, 8, 8,
-            					  new ECBlocks(5, new ECB(1, 3)))));
-  VERSIONS.push_back(Ref<Version>(new Version(2, 12, 12, 10, 10,
-            					  new ECBlocks(7, new ECB(1, 5)))));
-  VERSIONS.push_back(Ref<Version>(new Version(3, 14, 14, 12, 12,
-            					  new ECBlocks(10, new ECB(1, 8)))));
-  VERSIONS.push_back(Ref<Version>(new Version(4, 16, 16, 14, 14,
-            					  new ECBlocks(12, new ECB(1, 12)))));
-  VERSIONS.push_back(Ref<Version>(new Version(5, 18, 18, 16, 16,
-            					  new ECBlocks(14, new ECB(1, 18)))));
-  VERSIONS.push_back(Ref<Version>(new Version(6, 20, 20, 18, 18,
-            					  new ECBlocks(18, new ECB(1, 22)))));
-  VERSIONS.push_back(Ref<Version>(new Version(7, 22, 22, 20, 20,
-            					  new ECBlocks(20, new ECB(1, 30)))));
-  VERSIONS.push_back(Ref<Version>(new Version(8, 24, 24, 22, 22,
-            					  new ECBlocks(24, new ECB(1, 36)))));
-  VERSIONS.push_back(Ref<Version>(new Version(9, 26, 26, 24, 24,
-            					  new ECBlocks(28, new ECB(1, 44)))));
-  VERSIONS.push_back(Ref<Version>(new Version(10, 32, 32, 14, 14,
-            					  new ECBlocks(36, new ECB(1, 62)))));
-  VERSIONS.push_back(Ref<Version>(new Version(11, 36, 36, 16, 16,
-            					  new ECBlocks(42, new ECB(1, 86)))));
-  VERSIONS.push_back(Ref<Version>(new Version(12, 40, 40, 18, 18,
-            					  new ECBlocks(48, new ECB(1, 114)))));
-  VERSIONS.push_back(Ref<Version>(new Version(13, 44, 44, 20, 20,
-            					  new ECBlocks(56, new ECB(1, 144)))));
-  VERSIONS.push_back(Ref<Version>(new Version(14, 48, 48, 22, 22,
-            					  new ECBlocks(68, new ECB(1, 174)))));
-  VERSIONS.push_back(Ref<Version>(new Version(15, 52, 52, 24, 24,
-            					  new ECBlocks(42, new ECB(2, 102)))));
-  VERSIONS.push_back(Ref<Version>(new Version(16, 64, 64, 14, 14,
-            					  new ECBlocks(56, new ECB(2, 140)))));
-  VERSIONS.push_back(Ref<Version>(new Version(17, 72, 72, 16, 16,
-            					  new ECBlocks(36, new ECB(4, 92)))));
-  VERSIONS.push_back(Ref<Version>(new  Version(18, 80, 80, 18, 18,
-            					  new ECBlocks(48, new ECB(4, 114)))));
-  VERSIONS.push_back(Ref<Version>(new Version(19, 88, 88, 20, 20,
-            					  new ECBlocks(56, new ECB(4, 144)))));
-  VERSIONS.push_back(Ref<Version>(new Version(20, 96, 96, 22, 22,
-            					  new ECBlocks(68, new ECB(4, 174)))));
-  VERSIONS.push_back(Ref<Version>(new Version(21, 104, 104, 24, 24,
-            					  new ECBlocks(56, new ECB(6, 136)))));
-  VERSIONS.push_back(Ref<Version>(new Version(22, 120, 120, 18, 18,
-            					  new ECBlocks(68, new ECB(6, 175)))));
-  VERSIONS.push_back(Ref<Version>(new Version(23, 132, 132, 20, 20,
-            					  new ECBlocks(62, new ECB(8, 163)))));
-  VERSIONS.push_back(Ref<Version>(new Version(24, 144, 144, 22, 22,
-            					  new ECBlocks(62, new ECB(8, 156), new ECB(2, 155)))));
-  VERSIONS.push_back(Ref<Version>(new Version(25, 8, 18, 6, 16,
-            					  new ECBlocks(7, new ECB(1, 5)))));
-  VERSIONS.push_back(Ref<Version>(new Version(26, 8, 32, 6, 14,
-            					  new ECBlocks(11, new ECB(1, 10)))));
-  VERSIONS.push_back(Ref<Version>(new Version(27, 12, 26, 10, 24,
-					              new ECBlocks(14, new ECB(1, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(28, 12, 36, 10, 16,
-					              new ECBlocks(18, new ECB(1, 22)))));
-  VERSIONS.push_back(Ref<Version>(new Version(29, 16, 36, 14, 16,
-					              new ECBlocks(24, new ECB(1, 32)))));
-  VERSIONS.push_back(Ref<Version>(new Version(30, 16, 48, 14, 22,
-					              new ECBlocks(28, new ECB(1, 49)))));
-  return VERSIONS.size();
-}
 }
 }
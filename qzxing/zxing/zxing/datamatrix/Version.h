@@ -24,62 +24,78 @@
 #include <zxing/ReaderException.h>
 #include <zxing/common/BitMatrix.h>
 #include <zxing/common/Counted.h>
-#include <vector>
 
 namespace zxing {
 namespace datamatrix {
 
 class ECB {
 private:
+  friend class ECBlocks;
   int count_;
   int dataCodewords_;
 public:
-  ECB(int count, int dataCodewords);
-  int getCount();
-  int getDataCodewords();
+  constexpr ECB(int count, int dataCodewords) :
+      count_(count), dataCodewords_(dataCodewords) {
+  }
+  int getCount() const;
+  int getDataCodewords() const;
 };
 
 class ECBlocks {
 private:
   int ecCodewords_;
-  std::vector<ECB*> ecBlocks_;
+  int numECBlocks_;
+  ECB ecBlocks_[2];
 public:
-  ECBlocks(int ecCodewords, ECB *ecBlocks);
-  ECBlocks(int ecCodewords, ECB *ecBlocks1, ECB *ecBlocks2);
-  int getECCodewords();
-  std::vector<ECB*>& getECBlocks();
-  ~ECBlocks();
+  constexpr ECBlocks(int ecCodewords, ECB ecBlocks) :
+      ecCodewords_(ecCodewords), numECBlocks_(1), ecBlocks_{ecBlocks, ECB(0, 0)} {
+  }
+  constexpr ECBlocks(int ecCodewords, ECB ecBlocks1, ECB ecBlocks2) :
+      ecCodewords_(ecCodewords), numECBlocks_(2), ecBlocks_{ecBlocks1, ecBlocks2} {
+  }
+  // Unused ECB slots count zero blocks, so they add nothing here
+  constexpr int getTotalCodewords() const {
+    return ecBlocks_[0].count_ * (ecBlocks_[0].dataCodewords_ + ecCodewords_) +
+        ecBlocks_[1].count_ * (ecBlocks_[1].dataCodewords_ + ecCodewords_);
+  }
+  int getECCodewords() const;
+  int getNumECBlocks() const;
+  const ECB &getECBlock(int i) const;
 };
 
-class Version : public Counted {
+/**
+ * The Data Matrix versions are a constant table laid out by the compiler,
+ * see QR Code's Version. Versions are never freed, so plain pointers to
+ * them are safe to keep.
+ */
+class Version {
 private:
   int versionNumber_;
   int symbolSizeRows_;
   int symbolSizeColumns_;
   int dataRegionSizeRows_;
   int dataRegionSizeColumns_;
-  ECBlocks* ecBlocks_;
+  ECBlocks ecBlocks_;
   int totalCodewords_;
-  Version(int versionNumber, int symbolSizeRows, int symbolSizeColumns, int dataRegionSizeRows,
-		  int dataRegionSizeColumns, ECBlocks *ecBlocks);
+  constexpr Version(int versionNumber, int symbolSizeRows, int symbolSizeColumns, int dataRegionSizeRows,
+                    int dataRegionSizeColumns, ECBlocks ecBlocks) :
+      versionNumber_(versionNumber), symbolSizeRows_(symbolSizeRows), symbolSizeColumns_(symbolSizeColumns),
+      dataRegionSizeRows_(dataRegionSizeRows), dataRegionSizeColumns_(dataRegionSizeColumns),
+      ecBlocks_(ecBlocks), totalCodewords_(ecBlocks.getTotalCodewords()) {
+  }
+
+  static const Version VERSIONS[];
+  static const int N_VERSIONS;
 
 public:
-  static std::vector<Ref<Version> > VERSIONS;
-  
-  ~Version();
-  int getVersionNumber();
-  int getSymbolSizeRows();
-  int getSymbolSizeColumns();  
-  int getDataRegionSizeRows();  
-  int getDataRegionSizeColumns();
-  int getTotalCodewords();
-  ECBlocks* getECBlocks();
-  static int  buildVersions();  
-  Ref<Version> getVersionForDimensions(int numRows, int numColumns);
-  
-private:
-  Version(const Version&);
-  Version & operator=(const Version&);
+  int getVersionNumber() const;
+  int getSymbolSizeRows() const;
+  int getSymbolSizeColumns() const;
+  int getDataRegionSizeRows() const;
+  int getDataRegionSizeColumns() const;
+  int getTotalCodewords() const;
+  const ECBlocks &getECBlocks() const;
+  static const Version *getVersionForDimensions(int numRows, int numColumns);
 };
 }
 }
@@ -30,27 +30,23 @@
 namespace zxing {
 namespace datamatrix {
 
+/**
+ * Reads codewords straight off the sampled symbol. Where each codeword bit
+ * sits, once the alignment patterns between data regions are skipped and
+ * the Utah placement of ISO 16022 Annex F is applied, depends only on the
+ * version, so it is worked out once per version and kept.
+ */
 class BitMatrixParser : public Counted {
 private:
   Ref<BitMatrix> bitMatrix_;
-  Ref<Version> parsedVersion_;
-  Ref<BitMatrix> readBitMatrix_;
+  const Version *parsedVersion_;
 
   int copyBit(size_t x, size_t y, int versionBits);
 
 public:
   BitMatrixParser(Ref<BitMatrix> bitMatrix);
-  Ref<Version> readVersion(Ref<BitMatrix> bitMatrix);
+  const Version *readVersion(Ref<BitMatrix> bitMatrix);
   ArrayRef<char> readCodewords();
-  bool readModule(int row, int column, int numRows, int numColumns);
-
-private:
-  int readUtah(int row, int column, int numRows, int numColumns);
-  int readCorner1(int numRows, int numColumns);
-  int readCorner2(int numRows, int numColumns);
-  int readCorner3(int numRows, int numColumns);
-  int readCorner4(int numRows, int numColumns);
-  Ref<BitMatrix> extractDataRegion(Ref<BitMatrix> bitMatrix);
 };
 
 }
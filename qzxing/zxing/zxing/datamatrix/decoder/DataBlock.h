@@ -37,7 +37,7 @@ private:
   DataBlock(int numDataCodewords, ArrayRef<char> codewords);
 
 public:  
-  static std::vector<Ref<DataBlock> > getDataBlocks(ArrayRef<char> rawCodewords, Version *version);
+  static std::vector<Ref<DataBlock> > getDataBlocks(ArrayRef<char> rawCodewords, const Version *version);
 
   int getNumDataCodewords();
   ArrayRef<char> getCodewords();
@@ -19,342 +19,243 @@
  */
 
 #include <zxing/datamatrix/decoder/BitMatrixParser.h>
-#include <zxing/common/IllegalArgumentException.h>
-
-#include <iostream>
+#include <mutex>
+#include <vector>
 
 namespace zxing {
 namespace datamatrix {
 
-int BitMatrixParser::copyBit(size_t x, size_t y, int versionBits) {
-  return bitMatrix_->get(x, y) ? (versionBits << 1) | 0x1 : versionBits << 1;
-}
+namespace {
 
-BitMatrixParser::BitMatrixParser(Ref<BitMatrix> bitMatrix) : bitMatrix_(NULL),
-                                                             parsedVersion_(NULL),
-                                                             readBitMatrix_(NULL) {
-  size_t dimension = bitMatrix->getHeight();
-  if (dimension < 8 || dimension > 144 || (dimension & 0x01) != 0)
-    throw ReaderException("Dimension must be even, > 8 < 144");
+// ISO 16022:2006 Table 7 defines 24 square and 6 rectangular ECC 200 symbols
+const int NUM_VERSIONS = 30;
 
-  parsedVersion_ = readVersion(bitMatrix);
-  bitMatrix_ = extractDataRegion(bitMatrix);
-  readBitMatrix_ = new BitMatrix(bitMatrix_->getWidth(), bitMatrix_->getHeight());
-}
+// A module of the whole symbol, alignment patterns included
+struct Module {
+  unsigned char x;
+  unsigned char y;
+};
 
-Ref<Version> BitMatrixParser::readVersion(Ref<BitMatrix> bitMatrix) {
-  if (parsedVersion_ != 0) {
-    return parsedVersion_;
+/**
+ * Lays out one version's codewords following ISO 16022:2006 Annex F.
+ * Rows and columns here index the mapping matrix, the data regions
+ * butted together; each module is recorded at its place in the symbol.
+ */
+class Placement {
+private:
+  int numRows_;
+  int numColumns_;
+  int dataRegionSizeRows_;
+  int dataRegionSizeColumns_;
+  std::vector<bool> placed_;
+  std::vector<Module> &modules_;
+
+  void module(int row, int column) {
+    // Adjust the row and column indices based on boundary wrapping
+    if (row < 0) {
+      row += numRows_;
+      column += 4 - ((numRows_ + 4) & 0x07);
+    }
+    if (column < 0) {
+      column += numColumns_;
+      row += 4 - ((numColumns_ + 4) & 0x07);
+    }
+    placed_[row * numColumns_ + column] = true;
+    Module m;
+    m.x = (unsigned char) (column / dataRegionSizeColumns_ * (dataRegionSizeColumns_ + 2) + 1 +
+                           column % dataRegionSizeColumns_);
+    m.y = (unsigned char) (row / dataRegionSizeRows_ * (dataRegionSizeRows_ + 2) + 1 +
+                           row % dataRegionSizeRows_);
+    modules_.push_back(m);
   }
 
-  int numRows = bitMatrix->getHeight();
-  int numColumns = bitMatrix->getWidth();
+  bool isPlaced(int row, int column) const {
+    return placed_[row * numColumns_ + column];
+  }
 
-  Ref<Version> version = parsedVersion_->getVersionForDimensions(numRows, numColumns);
-  if (version != 0) {
-    return version;
+  void utah(int row, int column) {
+    module(row - 2, column - 2);
+    module(row - 2, column - 1);
+    module(row - 1, column - 2);
+    module(row - 1, column - 1);
+    module(row - 1, column);
+    module(row, column - 2);
+    module(row, column - 1);
+    module(row, column);
   }
-  throw ReaderException("Couldn't decode version");
-}
 
-ArrayRef<char> BitMatrixParser::readCodewords() {
-    ArrayRef<char> result(parsedVersion_->getTotalCodewords());
-    int resultOffset = 0;
+  void corner1() {
+    module(numRows_ - 1, 0);
+    module(numRows_ - 1, 1);
+    module(numRows_ - 1, 2);
+    module(0, numColumns_ - 2);
+    module(0, numColumns_ - 1);
+    module(1, numColumns_ - 1);
+    module(2, numColumns_ - 1);
+    module(3, numColumns_ - 1);
+  }
+
+  void corner2() {
+    module(numRows_ - 3, 0);
+    module(numRows_ - 2, 0);
+    module(numRows_ - 1, 0);
+    module(0, numColumns_ - 4);
+    module(0, numColumns_ - 3);
+    module(0, numColumns_ - 2);
+    module(0, numColumns_ - 1);
+    module(1, numColumns_ - 1);
+  }
+
+  void corner3() {
+    module(numRows_ - 1, 0);
+    module(numRows_ - 1, numColumns_ - 1);
+    module(0, numColumns_ - 3);
+    module(0, numColumns_ - 2);
+    module(0, numColumns_ - 1);
+    module(1, numColumns_ - 3);
+    module(1, numColumns_ - 2);
+    module(1, numColumns_ - 1);
+  }
+
+  void corner4() {
+    module(numRows_ - 3, 0);
+    module(numRows_ - 2, 0);
+    module(numRows_ - 1, 0);
+    module(0, numColumns_ - 2);
+    module(0, numColumns_ - 1);
+    module(1, numColumns_ - 1);
+    module(2, numColumns_ - 1);
+    module(3, numColumns_ - 1);
+  }
+
+public:
+  Placement(const Version *version, std::vector<Module> &modules) :
+      dataRegionSizeRows_(version->getDataRegionSizeRows()),
+      dataRegionSizeColumns_(version->getDataRegionSizeColumns()), modules_(modules) {
+    numRows_ = version->getSymbolSizeRows() / (dataRegionSizeRows_ + 2) * dataRegionSizeRows_;
+    numColumns_ = version->getSymbolSizeColumns() / (dataRegionSizeColumns_ + 2) * dataRegionSizeColumns_;
+    placed_.assign(numRows_ * numColumns_, false);
+    modules_.reserve(8 * version->getTotalCodewords());
+  }
+
+  void placeCodewords() {
     int row = 4;
     int column = 0;
 
-    int numRows = bitMatrix_->getHeight();
-    int numColumns = bitMatrix_->getWidth();
-
     bool corner1Read = false;
     bool corner2Read = false;
     bool corner3Read = false;
     bool corner4Read = false;
 
-    // Read all of the codewords
     do {
       // Check the four corner cases
-      if ((row == numRows) && (column == 0) && !corner1Read) {
-        result[resultOffset++] = (char) readCorner1(numRows, numColumns);
+      if ((row == numRows_) && (column == 0) && !corner1Read) {
+        corner1();
         row -= 2;
-        column +=2;
+        column += 2;
         corner1Read = true;
-      } else if ((row == numRows-2) && (column == 0) && ((numColumns & 0x03) != 0) && !corner2Read) {
-        result[resultOffset++] = (char) readCorner2(numRows, numColumns);
+      } else if ((row == numRows_ - 2) && (column == 0) && ((numColumns_ & 0x03) != 0) && !corner2Read) {
+        corner2();
         row -= 2;
-        column +=2;
+        column += 2;
         corner2Read = true;
-      } else if ((row == numRows+4) && (column == 2) && ((numColumns & 0x07) == 0) && !corner3Read) {
-        result[resultOffset++] = (char) readCorner3(numRows, numColumns);
+      } else if ((row == numRows_ + 4) && (column == 2) && ((numColumns_ & 0x07) == 0) && !corner3Read) {
+        corner3();
         row -= 2;
-        column +=2;
+        column += 2;
         corner3Read = true;
-      } else if ((row == numRows-2) && (column == 0) && ((numColumns & 0x07) == 4) && !corner4Read) {
-        result[resultOffset++] = (char) readCorner4(numRows, numColumns);
+      } else if ((row == numRows_ - 2) && (column == 0) && ((numColumns_ & 0x07) == 4) && !corner4Read) {
+        corner4();
         row -= 2;
-        column +=2;
+        column += 2;
         corner4Read = true;
       } else {
         // Sweep upward diagonally to the right
         do {
-          if ((row < numRows) && (column >= 0) && !readBitMatrix_->get(column, row)) {
-            result[resultOffset++] = (char) readUtah(row, column, numRows, numColumns);
+          if ((row < numRows_) && (column >= 0) && !isPlaced(row, column)) {
+            utah(row, column);
           }
           row -= 2;
-          column +=2;
-        } while ((row >= 0) && (column < numColumns));
+          column += 2;
+        } while ((row >= 0) && (column < numColumns_));
         row += 1;
-        column +=3;
+        column += 3;
 
         // Sweep downward diagonally to the left
         do {
-          if ((row >= 0) && (column < numColumns) && !readBitMatrix_->get(column, row)) {
-             result[resultOffset++] = (char) readUtah(row, column, numRows, numColumns);
+          if ((row >= 0) && (column < numColumns_) && !isPlaced(row, column)) {
+            utah(row, column);
           }
           row += 2;
-          column -=2;
-        } while ((row < numRows) && (column >= 0));
+          column -= 2;
+        } while ((row < numRows_) && (column >= 0));
         row += 3;
-        column +=1;
+        column += 1;
       }
-    } while ((row < numRows) || (column < numColumns));
+    } while ((row < numRows_) || (column < numColumns_));
+  }
+};
 
-    if (resultOffset != parsedVersion_->getTotalCodewords()) {
-      throw ReaderException("Did not read all codewords");
-    }
-    return result;
+std::once_flag placementOnce[NUM_VERSIONS];
+std::vector<Module> placements[NUM_VERSIONS];
+
+const std::vector<Module> &getPlacement(const Version *version) {
+  int index = version->getVersionNumber() - 1;
+  std::call_once(placementOnce[index], [version, index]() {
+    Placement placement(version, placements[index]);
+    placement.placeCodewords();
+  });
+  return placements[index];
 }
 
-bool BitMatrixParser::readModule(int row, int column, int numRows, int numColumns) {
-    // Adjust the row and column indices based on boundary wrapping
-    if (row < 0) {
-      row += numRows;
-      column += 4 - ((numRows + 4) & 0x07);
-    }
-    if (column < 0) {
-      column += numColumns;
-      row += 4 - ((numColumns + 4) & 0x07);
-    }
-    readBitMatrix_->set(column, row);
-    return bitMatrix_->get(column, row);
-  }
+}
 
-int BitMatrixParser::readUtah(int row, int column, int numRows, int numColumns) {
-    int currentByte = 0;
-    if (readModule(row - 2, column - 2, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(row - 2, column - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(row - 1, column - 2, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(row - 1, column - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(row - 1, column, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(row, column - 2, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(row, column - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(row, column, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    return currentByte;
-  }
+int BitMatrixParser::copyBit(size_t x, size_t y, int versionBits) {
+  return bitMatrix_->get(x, y) ? (versionBits << 1) | 0x1 : versionBits << 1;
+}
 
-int BitMatrixParser::readCorner1(int numRows, int numColumns) {
-    int currentByte = 0;
-    if (readModule(numRows - 1, 0, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(numRows - 1, 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(numRows - 1, 2, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 2, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(1, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(2, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(3, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    return currentByte;
+BitMatrixParser::BitMatrixParser(Ref<BitMatrix> bitMatrix) : bitMatrix_(bitMatrix),
+                                                             parsedVersion_(0) {
+  size_t dimension = bitMatrix->getHeight();
+  if (dimension < 8 || dimension > 144 || (dimension & 0x01) != 0)
+    throw ReaderException("Dimension must be even, > 8 < 144");
+
+  parsedVersion_ = readVersion(bitMatrix);
+}
+
+const Version *BitMatrixParser::readVersion(Ref<BitMatrix> bitMatrix) {
+  if (parsedVersion_ != 0) {
+    return parsedVersion_;
   }
 
-int BitMatrixParser::readCorner2(int numRows, int numColumns) {
-    int currentByte = 0;
-    if (readModule(numRows - 3, 0, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(numRows - 2, 0, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(numRows - 1, 0, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 4, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 3, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 2, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(1, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    return currentByte;
+  int numRows = bitMatrix->getHeight();
+  int numColumns = bitMatrix->getWidth();
+
+  const Version *version = Version::getVersionForDimensions(numRows, numColumns);
+  if (version != 0) {
+    return version;
   }
+  throw ReaderException("Couldn't decode version");
+}
 
-int BitMatrixParser::readCorner3(int numRows, int numColumns) {
-    int currentByte = 0;
-    if (readModule(numRows - 1, 0, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(numRows - 1, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 3, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 2, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(1, numColumns - 3, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(1, numColumns - 2, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(1, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    return currentByte;
+ArrayRef<char> BitMatrixParser::readCodewords() {
+  int totalCodewords = parsedVersion_->getTotalCodewords();
+  const std::vector<Module> &placement = getPlacement(parsedVersion_);
+  if ((int) placement.size() != 8 * totalCodewords) {
+    throw ReaderException("Did not read all codewords");
   }
 
-int BitMatrixParser::readCorner4(int numRows, int numColumns) {
+  ArrayRef<char> result(totalCodewords);
+  const BitMatrix &matrix = *bitMatrix_;
+  const Module *module = &placement[0];
+  for (int i = 0; i < totalCodewords; i++) {
     int currentByte = 0;
-    if (readModule(numRows - 3, 0, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(numRows - 2, 0, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(numRows - 1, 0, numRows, numColumns)) {
-      currentByte |= 1;
+    for (int bit = 0; bit < 8; bit++, module++) {
+      currentByte = (currentByte << 1) | (matrix.get(module->x, module->y) ? 1 : 0);
     }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 2, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(0, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(1, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(2, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    currentByte <<= 1;
-    if (readModule(3, numColumns - 1, numRows, numColumns)) {
-      currentByte |= 1;
-    }
-    return currentByte;
+    result[i] = (char) currentByte;
   }
-
-Ref<BitMatrix> BitMatrixParser::extractDataRegion(Ref<BitMatrix> bitMatrix) {
-    int symbolSizeRows = parsedVersion_->getSymbolSizeRows();
-    int symbolSizeColumns = parsedVersion_->getSymbolSizeColumns();
-
-    if ((int)bitMatrix->getHeight() != symbolSizeRows) {
-      throw IllegalArgumentException("Dimension of bitMatrix must match the version size");
-    }
-
-    int dataRegionSizeRows = parsedVersion_->getDataRegionSizeRows();
-    int dataRegionSizeColumns = parsedVersion_->getDataRegionSizeColumns();
-
-    int numDataRegionsRow = symbolSizeRows / dataRegionSizeRows;
-    int numDataRegionsColumn = symbolSizeColumns / dataRegionSizeColumns;
-
-    int sizeDataRegionRow = numDataRegionsRow * dataRegionSizeRows;
-    int sizeDataRegionColumn = numDataRegionsColumn * dataRegionSizeColumns;
-
-    Ref<BitMatrix> bitMatrixWithoutAlignment(new BitMatrix(sizeDataRegionColumn, sizeDataRegionRow));
-    for (int dataRegionRow = 0; dataRegionRow < numDataRegionsRow; ++dataRegionRow) {
-      int dataRegionRowOffset = dataRegionRow * dataRegionSizeRows;
-      for (int dataRegionColumn = 0; dataRegionColumn < numDataRegionsColumn; ++dataRegionColumn) {
-        int dataRegionColumnOffset = dataRegionColumn * dataRegionSizeColumns;
-        for (int i = 0; i < dataRegionSizeRows; ++i) {
-          int readRowOffset = dataRegionRow * (dataRegionSizeRows + 2) + 1 + i;
-          int writeRowOffset = dataRegionRowOffset + i;
-          for (int j = 0; j < dataRegionSizeColumns; ++j) {
-            int readColumnOffset = dataRegionColumn * (dataRegionSizeColumns + 2) + 1 + j;
-            if (bitMatrix->get(readColumnOffset, readRowOffset)) {
-              int writeColumnOffset = dataRegionColumnOffset + j;
-              bitMatrixWithoutAlignment->set(writeColumnOffset, writeRowOffset);
-            }
-          }
-        }
-      }
-    }
-    return bitMatrixWithoutAlignment;
+  return result;
 }
 
 }
@@ -38,26 +38,25 @@ ArrayRef<char> DataBlock::getCodewords() {
   return codewords_;
 }
 
-std::vector<Ref<DataBlock> > DataBlock::getDataBlocks(ArrayRef<char> rawCodewords, Version *version) {
+std::vector<Ref<DataBlock> > DataBlock::getDataBlocks(ArrayRef<char> rawCodewords, const Version *version) {
   // Figure out the number and size of data blocks used by this version and
   // error correction level
-  ECBlocks* ecBlocks = version->getECBlocks();
+  const ECBlocks &ecBlocks = version->getECBlocks();
 
   // First count the total number of data blocks
   int totalBlocks = 0;
-  vector<ECB*> ecBlockArray = ecBlocks->getECBlocks();
-  for (size_t i = 0; i < ecBlockArray.size(); i++) {
-    totalBlocks += ecBlockArray[i]->getCount();
+  for (int i = 0; i < ecBlocks.getNumECBlocks(); i++) {
+    totalBlocks += ecBlocks.getECBlock(i).getCount();
   }
 
   // Now establish DataBlocks of the appropriate size and number of data codewords
   std::vector<Ref<DataBlock> > result(totalBlocks);
   int numResultBlocks = 0;
-  for (size_t j = 0; j < ecBlockArray.size(); j++) {
-    ECB *ecBlock = ecBlockArray[j];
-    for (int i = 0; i < ecBlock->getCount(); i++) {
-      int numDataCodewords = ecBlock->getDataCodewords();
-      int numBlockCodewords = ecBlocks->getECCodewords() + numDataCodewords;
+  for (int j = 0; j < ecBlocks.getNumECBlocks(); j++) {
+    const ECB &ecBlock = ecBlocks.getECBlock(j);
+    for (int i = 0; i < ecBlock.getCount(); i++) {
+      int numDataCodewords = ecBlock.getDataCodewords();
+      int numBlockCodewords = ecBlocks.getECCodewords() + numDataCodewords;
       ArrayRef<char> buffer(numBlockCodewords);
       Ref<DataBlock> blockRef(new DataBlock(numDataCodewords, buffer));
       result[numResultBlocks++] = blockRef;
@@ -80,7 +79,7 @@ std::vector<Ref<DataBlock> > DataBlock::getDataBlocks(ArrayRef<char> rawCodeword
   }
   longerBlocksStartAt++;
 
-  int shorterBlocksNumDataCodewords = shorterBlocksTotalCodewords - ecBlocks->getECCodewords();
+  int shorterBlocksNumDataCodewords = shorterBlocksTotalCodewords - ecBlocks.getECCodewords();
   // The last elements of result may be 1 element longer;
   // first fill out as many elements as all of them have
   int rawCodewordsOffset = 0;
@@ -21,14 +21,65 @@
 
 #include <zxing/FormatException.h>
 #include <zxing/datamatrix/decoder/DecodedBitStreamParser.h>
-#include <iostream>
 #include <zxing/common/DecoderResult.h>
+#include <stdint.h>
 
 namespace zxing {
 namespace datamatrix {
 
 using namespace std;
 
+class DecodedBitStreamParser::BitReader {
+private:
+  const char *bytes_;
+  int size_;
+  int byteOffset_;   // next byte to be loaded into buffer_
+  uint64_t buffer_;  // unread bits, left aligned
+  int buffered_;
+
+  void fill() {
+    while (buffered_ <= 56 && byteOffset_ < size_) {
+      buffer_ |= (uint64_t) (unsigned char) bytes_[byteOffset_++] << (56 - buffered_);
+      buffered_ += 8;
+    }
+  }
+
+public:
+  BitReader(ArrayRef<char> &bytes) :
+      bytes_(bytes->size() > 0 ? &bytes[0] : 0), size_(bytes->size()),
+      byteOffset_(0), buffer_(0), buffered_(0) {
+  }
+
+  /**
+   * @param numBits number of bits to read, in [1,32]
+   * @throws FormatException if fewer than numBits remain
+   */
+  int readBits(int numBits) {
+    if (buffered_ < numBits) {
+      fill();
+      if (buffered_ < numBits) {
+        throw FormatException("Not enough bits to decode");
+      }
+    }
+    int result = (int) (buffer_ >> (64 - numBits));
+    buffer_ <<= numBits;
+    buffered_ -= numBits;
+    return result;
+  }
+
+  int available() const {
+    return 8 * (size_ - byteOffset_) + buffered_;
+  }
+
+  int getBitOffset() const {
+    return (8 * byteOffset_ - buffered_) & 7;
+  }
+
+  int getByteOffset() const {
+    return (8 * byteOffset_ - buffered_) >> 3;
+  }
+};
+
 const char DecodedBitStreamParser::C40_BASIC_SET_CHARS[] = {
     '*', '*', '*', ' ', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
     'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N',
@@ -52,10 +103,13 @@ const char DecodedBitStreamParser::TEXT_SHIFT3_SET_CHARS[] = {
 };
 
 Ref<DecoderResult> DecodedBitStreamParser::decode(ArrayRef<char> bytes) {
-  Ref<BitSource> bits(new BitSource(bytes));
-  ostringstream result;
-  ostringstream resultTrailer;
-  vector<char> byteSegments;
+  BitReader bits(bytes);
+  // Two digits per ASCII codeword or three characters per C40/Text pair is
+  // the most any codeword yields, bar the 05/06 macro headers.
+  string result;
+  result.reserve(2 * bytes->size() + 16);
+  string resultTrailer;
+  vector< ArrayRef<char> > byteSegments;
   int mode = ASCII_ENCODE;
   do {
     if (mode == ASCII_ENCODE) {
@@ -82,42 +136,45 @@ Ref<DecoderResult> DecodedBitStreamParser::decode(ArrayRef<char> bytes) {
       }
       mode = ASCII_ENCODE;
     }
-  } while (mode != PAD_ENCODE && bits->available() > 0);
+  } while (mode != PAD_ENCODE && bits.available() > 0);
 
-  if (resultTrailer.str().size() > 0) {
-    result << resultTrailer.str();
+  if (resultTrailer.size() > 0) {
+    result += resultTrailer;
   }
   ArrayRef<char> rawBytes(bytes);
-  Ref<String> text(new String(result.str()));
-  return Ref<DecoderResult>(new DecoderResult(rawBytes, text));
+  Ref<String> text(new String(result));
+  if (byteSegments.empty()) {
+    return Ref<DecoderResult>(new DecoderResult(rawBytes, text));
+  }
+  ArrayRef< ArrayRef<char> > segments(0);
+  segments->values().swap(byteSegments);
+  return Ref<DecoderResult>(new DecoderResult(rawBytes, text, segments, ""));
 }
 
-int DecodedBitStreamParser::decodeAsciiSegment(Ref<BitSource> bits, ostringstream & result,
-  ostringstream & resultTrailer) {
+int DecodedBitStreamParser::decodeAsciiSegment(BitReader & bits, string & result,
+  string & resultTrailer) {
   bool upperShift = false;
   do {
-    int oneByte = bits->readBits(8);
+    int oneByte = bits.readBits(8);
     if (oneByte == 0) {
       throw FormatException("Not enough bits to decode");
     } else if (oneByte <= 128) {  // ASCII data (ASCII value + 1)
       oneByte = upperShift ? (oneByte + 128) : oneByte;
       // upperShift = false;
-      result << (char) (oneByte - 1);
+      result += (char) (oneByte - 1);
       return ASCII_ENCODE;
     } else if (oneByte == 129) {  // Pad
       return PAD_ENCODE;
     } else if (oneByte <= 229) {  // 2-digit data 00-99 (Numeric Value + 130)
       int value = oneByte - 130;
-      if (value < 10) { // padd with '0' for single digit values
-        result << '0';
-      }
-      result << value;
+      result += (char) ('0' + value / 10);
+      result += (char) ('0' + value % 10);
     } else if (oneByte == 230) {  // Latch to C40 encodation
       return C40_ENCODE;
     } else if (oneByte == 231) {  // Latch to Base 256 encodation
       return BASE256_ENCODE;
     } else if (oneByte == 232) {  // FNC1
-      result << ((char) 29); // translate as ASCII 29
+      result += (char) 29; // translate as ASCII 29
     } else if (oneByte == 233 || oneByte == 234) {
       // Structured Append, Reader Programming
       // Ignore these symbols for now
@@ -125,11 +182,11 @@ int DecodedBitStreamParser::decodeAsciiSegment(Ref<BitSource> bits, ostringstrea
     } else if (oneByte == 235) {  // Upper Shift (shift to Extended ASCII)
       upperShift = true;
     } else if (oneByte == 236) {  // 05 Macro
-        result << ("[)>RS05GS");
-        resultTrailer << ("RSEOT");
+        result += "[)>RS05GS";
+        resultTrailer += "RSEOT";
     } else if (oneByte == 237) {  // 06 Macro
-      result << ("[)>RS06GS");
-      resultTrailer <<  ("RSEOT");
+      result += "[)>RS06GS";
+      resultTrailer += "RSEOT";
     } else if (oneByte == 238) {  // Latch to ANSI X12 encodation
       return ANSIX12_ENCODE;
     } else if (oneByte == 239) {  // Latch to Text encodation
@@ -142,15 +199,15 @@ int DecodedBitStreamParser::decodeAsciiSegment(Ref<BitSource> bits, ostringstrea
       // Ignore this symbol for now
     } else if (oneByte >= 242) { // Not to be used in ASCII encodation
       // ... but work around encoders that end with 254, latch back to ASCII
-      if (oneByte != 254 || bits->available() != 0) {
+      if (oneByte != 254 || bits.available() != 0) {
         throw FormatException("Not to be used in ASCII encodation");
       }
     }
-  } while (bits->available() > 0);
+  } while (bits.available() > 0);
   return ASCII_ENCODE;
 }
 
-void DecodedBitStreamParser::decodeC40Segment(Ref<BitSource> bits, ostringstream & result) {
+void DecodedBitStreamParser::decodeC40Segment(BitReader & bits, string & result) {
   // Three C40 values are encoded in a 16-bit value as
   // (1600 * C1) + (40 * C2) + C3 + 1
   // TODO(bbrown): The Upper Shift with C40 doesn't work in the 4 value scenario all the time
@@ -160,15 +217,15 @@ void DecodedBitStreamParser::decodeC40Segment(Ref<BitSource> bits, ostringstream
   int shift = 0;
   do {
     // If there is only one byte left then it will be encoded as ASCII
-    if (bits->available() == 8) {
+    if (bits.available() == 8) {
       return;
     }
-    int firstByte = bits->readBits(8);
+    int firstByte = bits.readBits(8);
     if (firstByte == 254) {  // Unlatch codeword
       return;
     }
 
-    parseTwoBytes(firstByte, bits->readBits(8), cValues);
+    parseTwoBytes(firstByte, bits.readBits(8), cValues);
 
     for (int i = 0; i < 3; i++) {
       int cValue = cValues[i];
@@ -178,32 +235,32 @@ void DecodedBitStreamParser::decodeC40Segment(Ref<BitSource> bits, ostringstream
             shift = cValue + 1;
           } else {
             if (upperShift) {
-              result << (char) (C40_BASIC_SET_CHARS[cValue] + 128);
+              result += (char) (C40_BASIC_SET_CHARS[cValue] + 128);
               upperShift = false;
             } else {
-              result << C40_BASIC_SET_CHARS[cValue];
+              result += C40_BASIC_SET_CHARS[cValue];
             }
           }
           break;
         case 1:
           if (upperShift) {
-            result << (char) (cValue + 128);
+            result += (char) (cValue + 128);
             upperShift = false;
           } else {
-            result << (char) cValue;
+            result += (char) cValue;
           }
           shift = 0;
           break;
         case 2:
           if (cValue < 27) {
             if (upperShift) {
-              result << (char) (C40_SHIFT2_SET_CHARS[cValue] + 128);
+              result += (char) (C40_SHIFT2_SET_CHARS[cValue] + 128);
               upperShift = false;
             } else {
-              result << C40_SHIFT2_SET_CHARS[cValue];
+              result += C40_SHIFT2_SET_CHARS[cValue];
             }
           } else if (cValue == 27) {  // FNC1
-            result << ((char) 29); // translate as ASCII 29
+            result += (char) 29; // translate as ASCII 29
           } else if (cValue == 30) {  // Upper Shift
             upperShift = true;
           } else {
@@ -213,10 +270,10 @@ void DecodedBitStreamParser::decodeC40Segment(Ref<BitSource> bits, ostringstream
           break;
         case 3:
           if (upperShift) {
-            result << (char) (cValue + 224);
+            result += (char) (cValue + 224);
             upperShift = false;
           } else {
-            result << (char) (cValue + 96);
+            result += (char) (cValue + 96);
           }
           shift = 0;
           break;
@@ -224,10 +281,10 @@ void DecodedBitStreamParser::decodeC40Segment(Ref<BitSource> bits, ostringstream
           throw FormatException("decodeC40Segment: no case");
       }
     }
-  } while (bits->available() > 0);
+  } while (bits.available() > 0);
 }
 
-void DecodedBitStreamParser::decodeTextSegment(Ref<BitSource> bits, ostringstream & result) {
+void DecodedBitStreamParser::decodeTextSegment(BitReader & bits, string & result) {
   // Three Text values are encoded in a 16-bit value as
   // (1600 * C1) + (40 * C2) + C3 + 1
   // TODO(bbrown): The Upper Shift with Text doesn't work in the 4 value scenario all the time
@@ -237,15 +294,15 @@ void DecodedBitStreamParser::decodeTextSegment(Ref<BitSource> bits, ostringstrea
   int shift = 0;
   do {
     // If there is only one byte left then it will be encoded as ASCII
-    if (bits->available() == 8) {
+    if (bits.available() == 8) {
       return;
     }
-    int firstByte = bits->readBits(8);
+    int firstByte = bits.readBits(8);
     if (firstByte == 254) {  // Unlatch codeword
       return;
     }
 
-    parseTwoBytes(firstByte, bits->readBits(8), cValues);
+    parseTwoBytes(firstByte, bits.readBits(8), cValues);
 
     for (int i = 0; i < 3; i++) {
       int cValue = cValues[i];
@@ -255,19 +312,19 @@ void DecodedBitStreamParser::decodeTextSegment(Ref<BitSource> bits, ostringstrea
             shift = cValue + 1;
           } else {
             if (upperShift) {
-              result << (char) (TEXT_BASIC_SET_CHARS[cValue] + 128);
+              result += (char) (TEXT_BASIC_SET_CHARS[cValue] + 128);
               upperShift = false;
             } else {
-              result << (TEXT_BASIC_SET_CHARS[cValue]);
+              result += TEXT_BASIC_SET_CHARS[cValue];
             }
           }
           break;
         case 1:
           if (upperShift) {
-            result << (char) (cValue + 128);
+            result += (char) (cValue + 128);
             upperShift = false;
           } else {
-            result << (char) (cValue);
+            result += (char) (cValue);
           }
           shift = 0;
           break;
@@ -275,13 +332,13 @@ void DecodedBitStreamParser::decodeTextSegment(Ref<BitSource> bits, ostringstrea
           // Shift 2 for Text is the same encoding as C40
           if (cValue < 27) {
             if (upperShift) {
-              result << (char) (C40_SHIFT2_SET_CHARS[cValue] + 128);
+              result += (char) (C40_SHIFT2_SET_CHARS[cValue] + 128);
               upperShift = false;
             } else {
-              result << (C40_SHIFT2_SET_CHARS[cValue]);
+              result += C40_SHIFT2_SET_CHARS[cValue];
             }
           } else if (cValue == 27) {  // FNC1
-            result << ((char) 29); // translate as ASCII 29
+            result += (char) 29; // translate as ASCII 29
           } else if (cValue == 30) {  // Upper Shift
             upperShift = true;
           } else {
@@ -291,10 +348,10 @@ void DecodedBitStreamParser::decodeTextSegment(Ref<BitSource> bits, ostringstrea
           break;
         case 3:
           if (upperShift) {
-            result << (char) (TEXT_SHIFT3_SET_CHARS[cValue] + 128);
+            result += (char) (TEXT_SHIFT3_SET_CHARS[cValue] + 128);
             upperShift = false;
           } else {
-            result << (TEXT_SHIFT3_SET_CHARS[cValue]);
+            result += TEXT_SHIFT3_SET_CHARS[cValue];
           }
           shift = 0;
           break;
@@ -302,45 +359,45 @@ void DecodedBitStreamParser::decodeTextSegment(Ref<BitSource> bits, ostringstrea
           throw FormatException("decodeTextSegment: no case");
       }
     }
-  } while (bits->available() > 0);
+  } while (bits.available() > 0);
 }
 
-void DecodedBitStreamParser::decodeAnsiX12Segment(Ref<BitSource> bits, ostringstream & result) {
+void DecodedBitStreamParser::decodeAnsiX12Segment(BitReader & bits, string & result) {
   // Three ANSI X12 values are encoded in a 16-bit value as
   // (1600 * C1) + (40 * C2) + C3 + 1
 
   int cValues[3];
   do {
     // If there is only one byte left then it will be encoded as ASCII
-    if (bits->available() == 8) {
+    if (bits.available() == 8) {
       return;
     }
-    int firstByte = bits->readBits(8);
+    int firstByte = bits.readBits(8);
     if (firstByte == 254) {  // Unlatch codeword
       return;
     }
 
-    parseTwoBytes(firstByte, bits->readBits(8), cValues);
+    parseTwoBytes(firstByte, bits.readBits(8), cValues);
 
     for (int i = 0; i < 3; i++) {
       int cValue = cValues[i];
       if (cValue == 0) {  // X12 segment terminator <CR>
-        result << '\r';
+        result += '\r';
       } else if (cValue == 1) {  // X12 segment separator *
-        result << '*';
+        result += '*';
       } else if (cValue == 2) {  // X12 sub-element separator >
-        result << '>';
+        result += '>';
       } else if (cValue == 3) {  // space
-        result << ' ';
+        result += ' ';
       } else if (cValue < 14) {  // 0 - 9
-        result << (char) (cValue + 44);
+        result += (char) (cValue + 44);
       } else if (cValue < 40) {  // A - Z
-        result << (char) (cValue + 51);
+        result += (char) (cValue + 51);
       } else {
         throw FormatException("decodeAnsiX12Segment: no case");
       }
     }
-  } while (bits->available() > 0);
+  } while (bits.available() > 0);
 }
 
 void DecodedBitStreamParser::parseTwoBytes(int firstByte, int secondByte, int* result) {
@@ -353,22 +410,22 @@ void DecodedBitStreamParser::parseTwoBytes(int firstByte, int secondByte, int* r
   result[2] = fullBitValue - temp * 40;
 }
   
-void DecodedBitStreamParser::decodeEdifactSegment(Ref<BitSource> bits, ostringstream & result) {
+void DecodedBitStreamParser::decodeEdifactSegment(BitReader & bits, string & result) {
   do {
     // If there is only two or less bytes left then it will be encoded as ASCII
-    if (bits->available() <= 16) {
+    if (bits.available() <= 16) {
       return;
     }
 
     for (int i = 0; i < 4; i++) {
-      int edifactValue = bits->readBits(6);
+      int edifactValue = bits.readBits(6);
 
       // Check for the unlatch character
       if (edifactValue == 0x1f) {  // 011111
         // Read rest of byte, which should be 0, and stop
-        int bitsLeft = 8 - bits->getBitOffset();
+        int bitsLeft = 8 - bits.getBitOffset();
         if (bitsLeft != 8) {
-          bits->readBits(bitsLeft);
+          bits.readBits(bitsLeft);
         }
         return;
       }
@@ -376,22 +433,23 @@ void DecodedBitStreamParser::decodeEdifactSegment(Ref<BitSource> bits, ostringst
       if ((edifactValue & 0x20) == 0) {  // no 1 in the leading (6th) bit
         edifactValue |= 0x40;  // Add a leading 01 to the 6 bit binary value
       }
-      result << (char)(edifactValue);
+      result += (char) (edifactValue);
     }
-  } while (bits->available() > 0);
+  } while (bits.available() > 0);
 }
   
-void DecodedBitStreamParser::decodeBase256Segment(Ref<BitSource> bits, ostringstream& result, vector<char> byteSegments) {
+void DecodedBitStreamParser::decodeBase256Segment(BitReader & bits, string & result,
+  vector< ArrayRef<char> > & byteSegments) {
   // Figure out how long the Base 256 Segment is.
-  int codewordPosition = 1 + bits->getByteOffset(); // position is 1-indexed
-  int d1 = unrandomize255State(bits->readBits(8), codewordPosition++);
+  int codewordPosition = 1 + bits.getByteOffset(); // position is 1-indexed
+  int d1 = unrandomize255State(bits.readBits(8), codewordPosition++);
   int count;
   if (d1 == 0) {  // Read the remainder of the symbol
-    count = bits->available() / 8;
+    count = bits.available() / 8;
   } else if (d1 < 250) {
     count = d1;
   } else {
-    count = 250 * (d1 - 249) + unrandomize255State(bits->readBits(8), codewordPosition++);
+    count = 250 * (d1 - 249) + unrandomize255State(bits.readBits(8), codewordPosition++);
   }
 
   // We're seeing NegativeArraySizeException errors from users.
@@ -399,17 +457,20 @@ void DecodedBitStreamParser::decodeBase256Segment(Ref<BitSource> bits, ostringst
     throw FormatException("NegativeArraySizeException");
   }
 
-  char* bytes = new char[count];
+  // Have seen this particular error in the wild, such as at
+  // http://www.bcgen.com/demo/IDAutomationStreamingDataMatrix.aspx?MODE=3&D=Fred&PFMT=3&PT=F&X=0.3&O=0&LM=0.2
+  if (bits.available() < 8 * count) {
+    throw FormatException("byteSegments");
+  }
+
+  ArrayRef<char> bytes(count);
   for (int i = 0; i < count; i++) {
-    // Have seen this particular error in the wild, such as at
-    // http://www.bcgen.com/demo/IDAutomationStreamingDataMatrix.aspx?MODE=3&D=Fred&PFMT=3&PT=F&X=0.3&O=0&LM=0.2
-    if (bits->available() < 8) {
-      throw FormatException("byteSegments");
-    }
-    bytes[i] = unrandomize255State(bits->readBits(8), codewordPosition++);
-    byteSegments.push_back(bytes[i]);
-    result << (char)bytes[i];
+    bytes[i] = unrandomize255State(bits.readBits(8), codewordPosition++);
+  }
+  if (count > 0) {
+    result.append(&bytes[0], count);
   }
+  byteSegments.push_back(bytes);
 }
 }
 }
@@ -60,7 +60,7 @@ void Decoder::correctErrors(ArrayRef<char> codewordBytes, int numDataCodewords)
 Ref<DecoderResult> Decoder::decode(Ref<BitMatrix> bits) {
   // Construct a parser and read version, error-correction level
   BitMatrixParser parser(bits);
-  Version *version = parser.readVersion(bits);
+  const Version *version = parser.readVersion(bits);
 
   // Read codewords
   ArrayRef<char> codewords(parser.readCodewords());
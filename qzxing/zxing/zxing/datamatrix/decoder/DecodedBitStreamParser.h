@@ -22,9 +22,8 @@
  */
 
 #include <string>
-#include <sstream>
+#include <vector>
 #include <zxing/common/Array.h>
-#include <zxing/common/BitSource.h>
 #include <zxing/common/Counted.h>
 #include <zxing/common/DecoderResult.h>
 
@@ -41,6 +40,13 @@ private:
   static const int ANSIX12_ENCODE = 4;
   static const int EDIFACT_ENCODE = 5;
   static const int BASE256_ENCODE = 6;
+
+  /**
+   * Reads the data codewords MSB first through a 64-bit buffer; defined
+   * inline in the implementation file so the segment loops don't pay for
+   * a call per read.
+   */
+  class BitReader;
     
   /**
    * See ISO 16022:2006, Annex C Table C.1
@@ -59,27 +65,27 @@ private:
   /**
    * See ISO 16022:2006, 5.2.3 and Annex C, Table C.2
    */
-  int decodeAsciiSegment(Ref<BitSource> bits, std::ostringstream &result, std::ostringstream &resultTrailer);
+  int decodeAsciiSegment(BitReader &bits, std::string &result, std::string &resultTrailer);
   /**
    * See ISO 16022:2006, 5.2.5 and Annex C, Table C.1
    */
-  void decodeC40Segment(Ref<BitSource> bits, std::ostringstream &result);
+  void decodeC40Segment(BitReader &bits, std::string &result);
   /**
    * See ISO 16022:2006, 5.2.6 and Annex C, Table C.2
    */
-  void decodeTextSegment(Ref<BitSource> bits, std::ostringstream &result);
+  void decodeTextSegment(BitReader &bits, std::string &result);
   /**
    * See ISO 16022:2006, 5.2.7
    */
-  void decodeAnsiX12Segment(Ref<BitSource> bits, std::ostringstream &result);
+  void decodeAnsiX12Segment(BitReader &bits, std::string &result);
   /**
    * See ISO 16022:2006, 5.2.8 and Annex C Table C.3
    */
-  void decodeEdifactSegment(Ref<BitSource> bits, std::ostringstream &result);
+  void decodeEdifactSegment(BitReader &bits, std::string &result);
   /**
    * See ISO 16022:2006, 5.2.9 and Annex B, B.2
    */
-  void decodeBase256Segment(Ref<BitSource> bits, std::ostringstream &result, std::vector<char> byteSegments);
+  void decodeBase256Segment(BitReader &bits, std::string &result, std::vector< ArrayRef<char> > &byteSegments);
 
   void parseTwoBytes(int firstByte, int secondByte, int* result);
   /**
@@ -91,7 +97,6 @@ private:
     int tempVariable = randomizedBase256Codeword - pseudoRandomNumber;
     return (char) (tempVariable >= 0 ? tempVariable : (tempVariable + 256));
   };
-  void append(std::ostream &ost, const char *bufIn, size_t nIn, const char *src);
 
 public:
   DecodedBitStreamParser() { };
@@ -19,7 +19,6 @@
  * limitations under the License.
  */
 
-#include <map>
 #include <zxing/ResultPoint.h>
 #include <zxing/common/GridSampler.h>
 #include <zxing/datamatrix/detector/Detector.h>
@@ -27,6 +26,7 @@
 #include <zxing/NotFoundException.h>
 #include <sstream>
 #include <cstdlib>
+#include <cmath>
 #include <algorithm>
 
 using std::abs;
@@ -37,39 +37,52 @@ using zxing::DetectorResult;
 using zxing::PerspectiveTransform;
 using zxing::NotFoundException;
 using zxing::datamatrix::Detector;
+using zxing::datamatrix::PointF;
 using zxing::datamatrix::ResultPointsAndTransitions;
 using zxing::common::detector::MathUtils;
 
 namespace {
-  typedef std::map<Ref<ResultPoint>, int> PointMap;
-  void increment(PointMap& table, Ref<ResultPoint> const& key) {
-    int& value = table[key];
-    value += 1;
+  bool equals(PointF const& a, PointF const& b) {
+    return a.x == b.x && a.y == b.y;
   }
-}
-
-ResultPointsAndTransitions::ResultPointsAndTransitions() {
-  Ref<ResultPoint> ref(new ResultPoint(0, 0));
-  from_ = ref;
-  to_ = ref;
-  transitions_ = 0;
-}
 
-ResultPointsAndTransitions::ResultPointsAndTransitions(Ref<ResultPoint> from, Ref<ResultPoint> to,
-                                                       int transitions)
-  : to_(to), from_(from), transitions_(transitions) {
-}
+  float patternDistance(PointF const& a, PointF const& b) {
+    float xDiff = a.x - b.x;
+    float yDiff = a.y - b.y;
+    return (float) sqrt((double) (xDiff * xDiff + yDiff * yDiff));
+  }
 
-Ref<ResultPoint> ResultPointsAndTransitions::getFrom() {
-  return from_;
-}
+  // ResultPoint::orderBestPatterns() on values: [A,B,C] such that AB < AC,
+  // BC < AC and the angle between BC and BA is less than 180 degrees
+  void orderBestPatterns(PointF patterns[3]) {
+    float zeroOneDistance = patternDistance(patterns[0], patterns[1]);
+    float oneTwoDistance = patternDistance(patterns[1], patterns[2]);
+    float zeroTwoDistance = patternDistance(patterns[0], patterns[2]);
+
+    PointF pointA, pointB, pointC;
+    if (oneTwoDistance >= zeroOneDistance && oneTwoDistance >= zeroTwoDistance) {
+      pointB = patterns[0];
+      pointA = patterns[1];
+      pointC = patterns[2];
+    } else if (zeroTwoDistance >= oneTwoDistance && zeroTwoDistance >= zeroOneDistance) {
+      pointB = patterns[1];
+      pointA = patterns[0];
+      pointC = patterns[2];
+    } else {
+      pointB = patterns[2];
+      pointA = patterns[0];
+      pointC = patterns[1];
+    }
 
-Ref<ResultPoint> ResultPointsAndTransitions::getTo() {
-  return to_;
-}
+    float crossProductZ = ((pointC.x - pointB.x) * (pointA.y - pointB.y)) - ((pointC.y - pointB.y) * (pointA.x - pointB.x));
+    if (crossProductZ < 0.0f) {
+      std::swap(pointA, pointC);
+    }
 
-int ResultPointsAndTransitions::getTransitions() {
-  return transitions_;
+    patterns[0] = pointA;
+    patterns[1] = pointB;
+    patterns[2] = pointC;
+  }
 }
 
 Detector::Detector(Ref<BitMatrix> image)
@@ -81,87 +94,76 @@ Ref<BitMatrix> Detector::getImage() {
 }
 
 Ref<DetectorResult> Detector::detect() {
-  Ref<WhiteRectangleDetector> rectangleDetector_(new WhiteRectangleDetector(image_));
-  std::vector<Ref<ResultPoint> > ResultPoints = rectangleDetector_->detect();
-  Ref<ResultPoint> pointA = ResultPoints[0];
-  Ref<ResultPoint> pointB = ResultPoints[1];
-  Ref<ResultPoint> pointC = ResultPoints[2];
-  Ref<ResultPoint> pointD = ResultPoints[3];
+  WhiteRectangleDetector rectangleDetector(image_);
+  std::vector<Ref<ResultPoint> > resultPoints = rectangleDetector.detect();
+  PointF points[4];
+  for (int i = 0; i < 4; i++) {
+    points[i].x = resultPoints[i]->getX();
+    points[i].y = resultPoints[i]->getY();
+  }
 
   // Point A and D are across the diagonal from one another,
   // as are B and C. Figure out which are the solid black lines
   // by counting transitions
-  std::vector<Ref<ResultPointsAndTransitions> > transitions(4);
-  transitions[0].reset(transitionsBetween(pointA, pointB));
-  transitions[1].reset(transitionsBetween(pointA, pointC));
-  transitions[2].reset(transitionsBetween(pointB, pointD));
-  transitions[3].reset(transitionsBetween(pointC, pointD));
-  insertionSort(transitions);
+  ResultPointsAndTransitions transitions[4] = {
+    {0, 1, transitionsBetween(points[0], points[1])},
+    {0, 2, transitionsBetween(points[0], points[2])},
+    {1, 3, transitionsBetween(points[1], points[3])},
+    {2, 3, transitionsBetween(points[2], points[3])}
+  };
+  insertionSort(transitions, 4);
 
   // Sort by number of transitions. First two will be the two solid sides; last two
   // will be the two alternating black/white sides
-  Ref<ResultPointsAndTransitions> lSideOne(transitions[0]);
-  Ref<ResultPointsAndTransitions> lSideTwo(transitions[1]);
-
-  // Figure out which point is their intersection by tallying up the number of times we see the
-  // endpoints in the four endpoints. One will show up twice.
-  typedef std::map<Ref<ResultPoint>, int> PointMap;
-  PointMap pointCount;
-  increment(pointCount, lSideOne->getFrom());
-  increment(pointCount, lSideOne->getTo());
-  increment(pointCount, lSideTwo->getFrom());
-  increment(pointCount, lSideTwo->getTo());
+  ResultPointsAndTransitions const& lSideOne = transitions[0];
+  ResultPointsAndTransitions const& lSideTwo = transitions[1];
 
   // Figure out which point is their intersection by tallying up the number of times we see the
   // endpoints in the four endpoints. One will show up twice.
-  Ref<ResultPoint> maybeTopLeft;
-  Ref<ResultPoint> bottomLeft;
-  Ref<ResultPoint> maybeBottomRight;
-  for (PointMap::const_iterator entry = pointCount.begin(), end = pointCount.end(); entry != end; ++entry) {
-    Ref<ResultPoint> const& point = entry->first;
-    int value = entry->second;
-    if (value == 2) {
-      bottomLeft = point; // this is definitely the bottom left, then -- end of two L sides
-    } else {
+  int pointCount[4] = {0, 0, 0, 0};
+  pointCount[lSideOne.from]++;
+  pointCount[lSideOne.to]++;
+  pointCount[lSideTwo.from]++;
+  pointCount[lSideTwo.to]++;
+
+  int maybeTopLeft = -1;
+  int bottomLeftIndex = -1;
+  int maybeBottomRight = -1;
+  for (int i = 0; i < 4; i++) {
+    if (pointCount[i] == 2) {
+      bottomLeftIndex = i; // this is definitely the bottom left, then -- end of two L sides
+    } else if (pointCount[i] == 1) {
       // Otherwise it's either top left or bottom right -- just assign the two arbitrarily now
-      if (maybeTopLeft == 0) {
-        maybeTopLeft = point;
+      if (maybeTopLeft == -1) {
+        maybeTopLeft = i;
       } else {
-        maybeBottomRight = point;
+        maybeBottomRight = i;
       }
     }
   }
 
-  if (maybeTopLeft == 0 || bottomLeft == 0 || maybeBottomRight == 0) {
+  if (maybeTopLeft == -1 || bottomLeftIndex == -1 || maybeBottomRight == -1) {
     throw NotFoundException();
   }
 
   // Bottom left is correct but top left and bottom right might be switched
-  std::vector<Ref<ResultPoint> > corners(3);
-  corners[0].reset(maybeTopLeft);
-  corners[1].reset(bottomLeft);
-  corners[2].reset(maybeBottomRight);
+  PointF corners[3] = {points[maybeTopLeft], points[bottomLeftIndex], points[maybeBottomRight]};
 
   // Use the dot product trick to sort them out
-  ResultPoint::orderBestPatterns(corners);
+  orderBestPatterns(corners);
 
   // Now we know which is which:
-  Ref<ResultPoint> bottomRight(corners[0]);
-  bottomLeft = corners[1];
-  Ref<ResultPoint> topLeft(corners[2]);
+  PointF bottomRight = corners[0];
+  PointF bottomLeft = corners[1];
+  PointF topLeft = corners[2];
 
   // Which point didn't we find in relation to the "L" sides? that's the top right corner
-  Ref<ResultPoint> topRight;
-  if (!(pointA->equals(bottomRight) || pointA->equals(bottomLeft) || pointA->equals(topLeft))) {
-    topRight = pointA;
-  } else if (!(pointB->equals(bottomRight) || pointB->equals(bottomLeft)
-               || pointB->equals(topLeft))) {
-    topRight = pointB;
-  } else if (!(pointC->equals(bottomRight) || pointC->equals(bottomLeft)
-               || pointC->equals(topLeft))) {
-    topRight = pointC;
-  } else {
-    topRight = pointD;
+  PointF topRight = points[3];
+  for (int i = 0; i < 3; i++) {
+    if (!(equals(points[i], bottomRight) || equals(points[i], bottomLeft) || equals(points[i], topLeft))) {
+      topRight = points[i];
+      break;
+    }
   }
 
   // Next determine the dimension by tracing along the top or right side and counting black/white
@@ -173,8 +175,8 @@ Ref<DetectorResult> Detector::detect() {
   // adjacent to the white module at the top right. Tracing to that corner from either the top left
   // or bottom right should work here.
 
-  int dimensionTop = transitionsBetween(topLeft, topRight)->getTransitions();
-  int dimensionRight = transitionsBetween(bottomRight, topRight)->getTransitions();
+  int dimensionTop = transitionsBetween(topLeft, topRight);
+  int dimensionRight = transitionsBetween(bottomRight, topRight);
 
   //dimensionTop++;
   if ((dimensionTop & 0x01) == 1) {
@@ -190,10 +192,9 @@ Ref<DetectorResult> Detector::detect() {
   }
   dimensionRight += 2;
 
-  Ref<BitMatrix> bits;
-  Ref<PerspectiveTransform> transform;
-  Ref<ResultPoint> correctedTopRight;
-
+  PointF correctedTopRight;
+  int dimensionX;
+  int dimensionY;
 
   // Rectanguar symbols are 6x16, 6x28, 10x24, 10x32, 14x32, or 14x44. If one dimension is more
   // than twice the other, it's certainly rectangular, but to cut a bit more slack we accept it as
@@ -202,12 +203,9 @@ Ref<DetectorResult> Detector::detect() {
     // The matrix is rectangular
     correctedTopRight = correctTopRightRectangular(bottomLeft, bottomRight, topLeft, topRight,
                                                    dimensionTop, dimensionRight);
-    if (correctedTopRight == NULL) {
-      correctedTopRight = topRight;
-    }
 
-    dimensionTop = transitionsBetween(topLeft, correctedTopRight)->getTransitions();
-    dimensionRight = transitionsBetween(bottomRight, correctedTopRight)->getTransitions();
+    dimensionTop = transitionsBetween(topLeft, correctedTopRight);
+    dimensionRight = transitionsBetween(bottomRight, correctedTopRight);
 
     if ((dimensionTop & 0x01) == 1) {
       // it can't be odd, so, round... up?
@@ -219,9 +217,8 @@ Ref<DetectorResult> Detector::detect() {
       dimensionRight++;
     }
 
-    transform = createTransform(topLeft, correctedTopRight, bottomLeft, bottomRight, dimensionTop,
-                                dimensionRight);
-    bits = sampleGrid(image_, dimensionTop, dimensionRight, transform);
+    dimensionX = dimensionTop;
+    dimensionY = dimensionRight;
 
   } else {
     // The matrix is square
@@ -229,134 +226,122 @@ Ref<DetectorResult> Detector::detect() {
 
     // correct top right point to match the white module
     correctedTopRight = correctTopRight(bottomLeft, bottomRight, topLeft, topRight, dimension);
-    if (correctedTopRight == NULL) {
-      correctedTopRight = topRight;
-    }
 
     // Redetermine the dimension using the corrected top right point
-    int dimensionCorrected = std::max(transitionsBetween(topLeft, correctedTopRight)->getTransitions(),
-                                      transitionsBetween(bottomRight, correctedTopRight)->getTransitions());
+    int dimensionCorrected = std::max(transitionsBetween(topLeft, correctedTopRight),
+                                      transitionsBetween(bottomRight, correctedTopRight));
     dimensionCorrected++;
     if ((dimensionCorrected & 0x01) == 1) {
       dimensionCorrected++;
     }
 
-    transform = createTransform(topLeft, correctedTopRight, bottomLeft, bottomRight,
-                                dimensionCorrected, dimensionCorrected);
-    bits = sampleGrid(image_, dimensionCorrected, dimensionCorrected, transform);
+    dimensionX = dimensionCorrected;
+    dimensionY = dimensionCorrected;
   }
 
-  ArrayRef< Ref<ResultPoint> > points (new Array< Ref<ResultPoint> >(4));
-  points[0].reset(topLeft);
-  points[1].reset(bottomLeft);
-  points[2].reset(correctedTopRight);
-  points[3].reset(bottomRight);
-  Ref<DetectorResult> detectorResult(new DetectorResult(bits, points));
+  // Only the corners that make it into the result become ResultPoints
+  ArrayRef< Ref<ResultPoint> > resultCorners (new Array< Ref<ResultPoint> >(4));
+  resultCorners[0].reset(new ResultPoint(topLeft.x, topLeft.y));
+  resultCorners[1].reset(new ResultPoint(bottomLeft.x, bottomLeft.y));
+  resultCorners[2].reset(new ResultPoint(correctedTopRight.x, correctedTopRight.y));
+  resultCorners[3].reset(new ResultPoint(bottomRight.x, bottomRight.y));
+  Ref<PerspectiveTransform> transform = createTransform(resultCorners[0], resultCorners[2], resultCorners[1],
+                                                        resultCorners[3], dimensionX, dimensionY);
+  Ref<BitMatrix> bits = sampleGrid(image_, dimensionX, dimensionY, transform);
+  Ref<DetectorResult> detectorResult(new DetectorResult(bits, resultCorners));
   return detectorResult;
 }
 
 /**
  * Calculates the position of the white top right module using the output of the rectangle detector
- * for a rectangular matrix
+ * for a rectangular matrix. Falls back to topRight if neither candidate lies in the image.
  */
-Ref<ResultPoint> Detector::correctTopRightRectangular(Ref<ResultPoint> bottomLeft,
-                                                      Ref<ResultPoint> bottomRight, Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight,
-                                                      int dimensionTop, int dimensionRight) {
+PointF Detector::correctTopRightRectangular(PointF bottomLeft, PointF bottomRight, PointF topLeft,
+                                            PointF topRight, int dimensionTop, int dimensionRight) {
 
   float corr = distance(bottomLeft, bottomRight) / (float) dimensionTop;
   int norm = distance(topLeft, topRight);
-  float cos = (topRight->getX() - topLeft->getX()) / norm;
-  float sin = (topRight->getY() - topLeft->getY()) / norm;
+  float cos = (topRight.x - topLeft.x) / norm;
+  float sin = (topRight.y - topLeft.y) / norm;
 
-  Ref<ResultPoint> c1(
-    new ResultPoint(topRight->getX() + corr * cos, topRight->getY() + corr * sin));
+  PointF c1 = {topRight.x + corr * cos, topRight.y + corr * sin};
 
   corr = distance(bottomLeft, topLeft) / (float) dimensionRight;
   norm = distance(bottomRight, topRight);
-  cos = (topRight->getX() - bottomRight->getX()) / norm;
-  sin = (topRight->getY() - bottomRight->getY()) / norm;
+  cos = (topRight.x - bottomRight.x) / norm;
+  sin = (topRight.y - bottomRight.y) / norm;
 
-  Ref<ResultPoint> c2(
-    new ResultPoint(topRight->getX() + corr * cos, topRight->getY() + corr * sin));
+  PointF c2 = {topRight.x + corr * cos, topRight.y + corr * sin};
 
   if (!isValid(c1)) {
     if (isValid(c2)) {
       return c2;
     }
-    return Ref<ResultPoint>(NULL);
+    return topRight;
   }
   if (!isValid(c2)) {
     return c1;
   }
 
-  int l1 = abs(dimensionTop - transitionsBetween(topLeft, c1)->getTransitions())
-    + abs(dimensionRight - transitionsBetween(bottomRight, c1)->getTransitions());
-  int l2 = abs(dimensionTop - transitionsBetween(topLeft, c2)->getTransitions())
-    + abs(dimensionRight - transitionsBetween(bottomRight, c2)->getTransitions());
+  int l1 = abs(dimensionTop - transitionsBetween(topLeft, c1))
+    + abs(dimensionRight - transitionsBetween(bottomRight, c1));
+  int l2 = abs(dimensionTop - transitionsBetween(topLeft, c2))
+    + abs(dimensionRight - transitionsBetween(bottomRight, c2));
 
   return l1 <= l2 ? c1 : c2;
 }
 
 /**
  * Calculates the position of the white top right module using the output of the rectangle detector
- * for a square matrix
+ * for a square matrix. Falls back to topRight if neither candidate lies in the image.
  */
-Ref<ResultPoint> Detector::correctTopRight(Ref<ResultPoint> bottomLeft,
-                                           Ref<ResultPoint> bottomRight, Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight,
-                                           int dimension) {
+PointF Detector::correctTopRight(PointF bottomLeft, PointF bottomRight, PointF topLeft, PointF topRight,
+                                 int dimension) {
 
   float corr = distance(bottomLeft, bottomRight) / (float) dimension;
   int norm = distance(topLeft, topRight);
-  float cos = (topRight->getX() - topLeft->getX()) / norm;
-  float sin = (topRight->getY() - topLeft->getY()) / norm;
+  float cos = (topRight.x - topLeft.x) / norm;
+  float sin = (topRight.y - topLeft.y) / norm;
 
-  Ref<ResultPoint> c1(
-    new ResultPoint(topRight->getX() + corr * cos, topRight->getY() + corr * sin));
+  PointF c1 = {topRight.x + corr * cos, topRight.y + corr * sin};
 
   corr = distance(bottomLeft, topLeft) / (float) dimension;
   norm = distance(bottomRight, topRight);
-  cos = (topRight->getX() - bottomRight->getX()) / norm;
-  sin = (topRight->getY() - bottomRight->getY()) / norm;
+  cos = (topRight.x - bottomRight.x) / norm;
+  sin = (topRight.y - bottomRight.y) / norm;
 
-  Ref<ResultPoint> c2(
-    new ResultPoint(topRight->getX() + corr * cos, topRight->getY() + corr * sin));
+  PointF c2 = {topRight.x + corr * cos, topRight.y + corr * sin};
 
   if (!isValid(c1)) {
     if (isValid(c2)) {
       return c2;
     }
-    return Ref<ResultPoint>(NULL);
+    return topRight;
   }
   if (!isValid(c2)) {
     return c1;
   }
 
-  int l1 = abs(
-    transitionsBetween(topLeft, c1)->getTransitions()
-    - transitionsBetween(bottomRight, c1)->getTransitions());
-  int l2 = abs(
-    transitionsBetween(topLeft, c2)->getTransitions()
-    - transitionsBetween(bottomRight, c2)->getTransitions());
+  int l1 = abs(transitionsBetween(topLeft, c1) - transitionsBetween(bottomRight, c1));
+  int l2 = abs(transitionsBetween(topLeft, c2) - transitionsBetween(bottomRight, c2));
 
   return l1 <= l2 ? c1 : c2;
 }
 
-bool Detector::isValid(Ref<ResultPoint> p) {
-  return p->getX() >= 0 && p->getX() < image_->getWidth() && p->getY() > 0
-    && p->getY() < image_->getHeight();
+bool Detector::isValid(PointF p) {
+  return p.x >= 0 && p.x < image_->getWidth() && p.y > 0 && p.y < image_->getHeight();
 }
 
-int Detector::distance(Ref<ResultPoint> a, Ref<ResultPoint> b) {
-  return MathUtils::round(ResultPoint::distance(a, b));
+int Detector::distance(PointF a, PointF b) {
+  return MathUtils::round(MathUtils::distance(a.x, a.y, b.x, b.y));
 }
 
-Ref<ResultPointsAndTransitions> Detector::transitionsBetween(Ref<ResultPoint> from,
-                                                             Ref<ResultPoint> to) {
+int Detector::transitionsBetween(PointF from, PointF to) {
   // See QR Code Detector, sizeOfBlackWhiteBlackRun()
-  int fromX = (int) from->getX();
-  int fromY = (int) from->getY();
-  int toX = (int) to->getX();
-  int toY = (int) to->getY();
+  int fromX = (int) from.x;
+  int fromY = (int) from.y;
+  int toX = (int) to.x;
+  int toY = (int) to.y;
   bool steep = abs(toY - fromY) > abs(toX - fromX);
   if (steep) {
     int temp = fromX;
@@ -374,13 +359,35 @@ Ref<ResultPointsAndTransitions> Detector::transitionsBetween(Ref<ResultPoint> fr
   int xstep = fromX < toX ? 1 : -1;
   int transitions = 0;
   bool inBlack = image_->get(steep ? fromY : fromX, steep ? fromX : fromY);
-  for (int x = fromX, y = fromY; x != toX; x += xstep) {
-    bool isBlack = image_->get(steep ? y : x, steep ? x : y);
-    if (isBlack != inBlack) {
-      transitions++;
-      inBlack = isBlack;
+  // The line is a series of runs that each stay on one y. They are taken a
+  // run at a time, a row run being counted a word at a time.
+  for (int x = fromX, y = fromY; x != toX;) {
+    int run = abs(toX - x);
+    if (dy > 0) {
+      // error <= 0 at the start of a run, y moves on once it turns positive
+      run = std::min(run, -error / dy + 1);
+    }
+    int lastX = x + (run - 1) * xstep;
+    if (steep) {
+      for (int i = x; ; i += xstep) {
+        bool isBlack = image_->get(y, i);
+        if (isBlack != inBlack) {
+          transitions++;
+          inBlack = isBlack;
+        }
+        if (i == lastX) {
+          break;
+        }
+      }
+    } else {
+      if (image_->get(x, y) != inBlack) {
+        transitions++;
+      }
+      transitions += image_->countTransitions(std::min(x, lastX), std::max(x, lastX), y);
+      inBlack = image_->get(lastX, y);
     }
-    error += dy;
+    x = lastX + xstep;
+    error += run * dy;
     if (error > 0) {
       if (y == toY) {
         break;
@@ -389,8 +396,7 @@ Ref<ResultPointsAndTransitions> Detector::transitionsBetween(Ref<ResultPoint> fr
       error -= dx;
     }
   }
-  Ref<ResultPointsAndTransitions> result(new ResultPointsAndTransitions(from, to, transitions));
-  return result;
+  return transitions;
 }
 
 Ref<PerspectiveTransform> Detector::createTransform(Ref<ResultPoint> topLeft,
@@ -424,24 +430,14 @@ Ref<BitMatrix> Detector::sampleGrid(Ref<BitMatrix> image, int dimensionX, int di
   return sampler.sampleGrid(image, dimensionX, dimensionY, transform);
 }
 
-void Detector::insertionSort(std::vector<Ref<ResultPointsAndTransitions> > &vector) {
-  int max = vector.size();
-  bool swapped = true;
-  Ref<ResultPointsAndTransitions> value;
-  Ref<ResultPointsAndTransitions> valueB;
-  do {
-    swapped = false;
-    for (int i = 1; i < max; i++) {
-      value = vector[i - 1];
-      if (compare(value, (valueB = vector[i])) > 0){
-        swapped = true;
-        vector[i - 1].reset(valueB);
-        vector[i].reset(value);
-      }
+void Detector::insertionSort(ResultPointsAndTransitions *transitions, int count) {
+  // Stable, so sides with as many transitions keep their order
+  for (int i = 1; i < count; i++) {
+    ResultPointsAndTransitions value = transitions[i];
+    int j = i;
+    for (; j > 0 && transitions[j - 1].transitions > value.transitions; j--) {
+      transitions[j] = transitions[j - 1];
     }
-  } while (swapped);
-}
-
-int Detector::compare(Ref<ResultPointsAndTransitions> a, Ref<ResultPointsAndTransitions> b) {
-  return a->getTransitions() - b->getTransitions();
+    transitions[j] = value;
+  }
 }
@@ -31,18 +31,23 @@
 namespace zxing {
 namespace datamatrix {
 
-class ResultPointsAndTransitions: public Counted {
-  private:
-    Ref<ResultPoint> to_;
-    Ref<ResultPoint> from_;
-    int transitions_;
+/**
+ * A point of the image, held by value while the corners are sorted out.
+ */
+struct PointF {
+  float x;
+  float y;
+};
 
-  public:
-    ResultPointsAndTransitions();
-    ResultPointsAndTransitions(Ref<ResultPoint> from, Ref<ResultPoint> to, int transitions);
-    Ref<ResultPoint> getFrom();
-    Ref<ResultPoint> getTo();
-    int getTransitions();
+/**
+ * A side between two of the four corners found by the white rectangle
+ * detector, given as indexes into those corners, and how often the colour
+ * changes along it.
+ */
+struct ResultPointsAndTransitions {
+  int from;
+  int to;
+  int transitions;
 };
 
 class Detector: public Counted {
@@ -53,16 +58,15 @@ class Detector: public Counted {
     Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image, int dimensionX, int dimensionY,
         Ref<PerspectiveTransform> transform);
 
-    void insertionSort(std::vector<Ref<ResultPointsAndTransitions> >& vector);
+    void insertionSort(ResultPointsAndTransitions *transitions, int count);
 
-    Ref<ResultPoint> correctTopRightRectangular(Ref<ResultPoint> bottomLeft,
-        Ref<ResultPoint> bottomRight, Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight,
-        int dimensionTop, int dimensionRight);
-    Ref<ResultPoint> correctTopRight(Ref<ResultPoint> bottomLeft, Ref<ResultPoint> bottomRight,
-        Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight, int dimension);
-    bool isValid(Ref<ResultPoint> p);
-    int distance(Ref<ResultPoint> a, Ref<ResultPoint> b);
-    Ref<ResultPointsAndTransitions> transitionsBetween(Ref<ResultPoint> from, Ref<ResultPoint> to);
+    PointF correctTopRightRectangular(PointF bottomLeft, PointF bottomRight, PointF topLeft,
+        PointF topRight, int dimensionTop, int dimensionRight);
+    PointF correctTopRight(PointF bottomLeft, PointF bottomRight, PointF topLeft, PointF topRight,
+        int dimension);
+    bool isValid(PointF p);
+    int distance(PointF a, PointF b);
+    int transitionsBetween(PointF from, PointF to);
     int min(int a, int b) {
       return a > b ? b : a;
     }
@@ -83,9 +87,6 @@ class Detector: public Counted {
         int dimensionX, int dimensionY);
 
     Ref<DetectorResult> detect();
-
-  private:
-    int compare(Ref<ResultPointsAndTransitions> a, Ref<ResultPointsAndTransitions> b);
 };
 
 }
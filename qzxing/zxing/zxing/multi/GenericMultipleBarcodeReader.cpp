@@ -18,6 +18,8 @@
 #include <zxing/multi/GenericMultipleBarcodeReader.h>
 #include <zxing/ReaderException.h>
 #include <zxing/ResultPoint.h>
+#include <algorithm>
+#include <cmath>
 
 using std::vector;
 using zxing::Ref;
@@ -37,7 +39,8 @@ GenericMultipleBarcodeReader::~GenericMultipleBarcodeReader(){}
 vector<Ref<Result> > GenericMultipleBarcodeReader::decodeMultiple(Ref<BinaryBitmap> image,
                                                                   DecodeHints hints) {
   vector<Ref<Result> > results;
-  doDecodeMultiple(image, hints, results, 0, 0, 0);
+  std::set<vector<int> > scanned;
+  doDecodeMultiple(image, hints, results, scanned, 0, 0, 0);
   if (results.empty()){
     throw ReaderException("No code detected");
   }
@@ -47,12 +50,23 @@ vector<Ref<Result> > GenericMultipleBarcodeReader::decodeMultiple(Ref<BinaryBitm
 void GenericMultipleBarcodeReader::doDecodeMultiple(Ref<BinaryBitmap> image, 
                                                     DecodeHints hints,
                                                     vector<Ref<Result> >& results,
+                                                    std::set<vector<int> >& scanned,
                                                     int xOffset,
                                                     int yOffset,
                                                     int currentDepth) {
   if (currentDepth > MAX_DEPTH) {
     return;
   }
+  // Searching left then above reaches the same region as above then left
+  // when both find the same code, it is only scanned once.
+  vector<int> region(4);
+  region[0] = xOffset;
+  region[1] = yOffset;
+  region[2] = image->getWidth();
+  region[3] = image->getHeight();
+  if (!scanned.insert(region).second) {
+    return;
+  }
   Ref<Result> result;
   try {
     result = delegate_.decode(image, hints);
@@ -60,67 +74,97 @@ void GenericMultipleBarcodeReader::doDecodeMultiple(Ref<BinaryBitmap> image,
     (void)ignored;
     return;
   }
+  Ref<Result> translated = translateResultPoints(result, xOffset, yOffset);
   bool alreadyFound = false;
   for (unsigned int i = 0; i < results.size(); i++) {
-    Ref<Result> existingResult = results[i];
-    if (existingResult->getText()->getText() == result->getText()->getText()) {
+    if (isSameCode(results[i], translated)) {
       alreadyFound = true;
       break;
     }
   }
   if (!alreadyFound) {
-    results.push_back(translateResultPoints(result, xOffset, yOffset));
+    results.push_back(translated);
   }
   
-  ArrayRef< Ref<ResultPoint> > resultPoints = result->getResultPoints();
-  if (resultPoints->empty()) {
-    return;
-  }
-
   int width = image->getWidth();
   int height = image->getHeight();
   float minX = float(width);
   float minY = float(height);
   float maxX = 0.0f;
   float maxY = 0.0f;
-  for (int i = 0; i < resultPoints->size(); i++) {
-    Ref<ResultPoint> point = resultPoints[i];
-    float x = point->getX();
-    float y = point->getY();
-    if (x < minX) {
-      minX = x;
-    }
-    if (y < minY) {
-      minY = y;
-    }
-    if (x > maxX) {
-      maxX = x;
-    }
-    if (y > maxY) {
-      maxY = y;
-    }
+  if (!getBounds(result, minX, minY, maxX, maxY)) {
+    return;
   }
 
   // Decode left of barcode
   if (minX > MIN_DIMENSION_TO_RECUR) {
     doDecodeMultiple(image->crop(0, 0, (int) minX, height), 
-                     hints, results, xOffset, yOffset, currentDepth+1);
+                     hints, results, scanned, xOffset, yOffset, currentDepth+1);
   }
   // Decode above barcode
   if (minY > MIN_DIMENSION_TO_RECUR) {
     doDecodeMultiple(image->crop(0, 0, width, (int) minY), 
-                     hints, results, xOffset, yOffset, currentDepth+1);
+                     hints, results, scanned, xOffset, yOffset, currentDepth+1);
   }
   // Decode right of barcode
   if (maxX < width - MIN_DIMENSION_TO_RECUR) {
     doDecodeMultiple(image->crop((int) maxX, 0, width - (int) maxX, height), 
-                     hints, results, xOffset + (int) maxX, yOffset, currentDepth+1);
+                     hints, results, scanned, xOffset + (int) maxX, yOffset, currentDepth+1);
   }
   // Decode below barcode
   if (maxY < height - MIN_DIMENSION_TO_RECUR) {
     doDecodeMultiple(image->crop(0, (int) maxY, width, height - (int) maxY), 
-                     hints, results, xOffset, yOffset + (int) maxY, currentDepth+1);
+                     hints, results, scanned, xOffset, yOffset + (int) maxY, currentDepth+1);
+  }
+}
+
+/**
+ * Two results are the same code when they have the same text and neither
+ * centre is further from the other than the size of the code. Two labels
+ * with the same text in different places are both reported.
+ */
+bool GenericMultipleBarcodeReader::isSameCode(Ref<Result> a, Ref<Result> b) {
+  if (a->getText()->getText() != b->getText()->getText()) {
+    return false;
+  }
+  float minX = 1e9f, minY = 1e9f, maxX = 0.0f, maxY = 0.0f;
+  float otherMinX = 1e9f, otherMinY = 1e9f, otherMaxX = 0.0f, otherMaxY = 0.0f;
+  if (!getBounds(b, minX, minY, maxX, maxY) || !getBounds(a, otherMinX, otherMinY, otherMaxX, otherMaxY)) {
+    return true;
+  }
+  float dx = (minX + maxX - otherMinX - otherMaxX) / 2;
+  float dy = (minY + maxY - otherMinY - otherMaxY) / 2;
+  float size = std::max(otherMaxX - otherMinX, otherMaxY - otherMinY);
+  return std::abs(dx) <= size && std::abs(dy) <= size;
+}
+
+bool GenericMultipleBarcodeReader::getBounds(Ref<Result> result,
+                                             float& minX,
+                                             float& minY,
+                                             float& maxX,
+                                             float& maxY) {
+  ArrayRef< Ref<ResultPoint> > resultPoints = result->getResultPoints();
+  if (resultPoints->empty()) {
+    return false;
+  }
+  for (int i = 0; i < resultPoints->size(); i++) {
+    Ref<ResultPoint> point = resultPoints[i];
+    float x = point->getX();
+    float y = point->getY();
+    if (x < minX) {
+      minX = x;
+    }
+    if (y < minY) {
+      minY = y;
+    }
+    if (x > maxX) {
+      maxX = x;
+    }
+    if (y > maxY) {
+      maxY = y;
+    }
   }
+  return true;
 }
 
 Ref<Result> GenericMultipleBarcodeReader::translateResultPoints(Ref<Result> result, int xOffset, int yOffset){
@@ -128,10 +172,10 @@ Ref<Result> GenericMultipleBarcodeReader::translateResultPoints(Ref<Result> resu
   if (oldResultPoints->empty()) {
     return result;
   }
-  ArrayRef< Ref<ResultPoint> > newResultPoints;
+  ArrayRef< Ref<ResultPoint> > newResultPoints(oldResultPoints->size());
   for (int i = 0; i < oldResultPoints->size(); i++) {
     Ref<ResultPoint> oldPoint = oldResultPoints[i];
-    newResultPoints->values().push_back(Ref<ResultPoint>(new ResultPoint(oldPoint->getX() + xOffset, oldPoint->getY() + yOffset)));
+    newResultPoints[i] = Ref<ResultPoint>(new ResultPoint(oldPoint->getX() + xOffset, oldPoint->getY() + yOffset));
   }
   return Ref<Result>(new Result(result->getText(), result->getRawBytes(), newResultPoints, result->getBarcodeFormat()));
 }
@@ -20,6 +20,7 @@
 
 #include <zxing/multi/MultipleBarcodeReader.h>
 #include <zxing/Reader.h>
+#include <set>
 
 namespace zxing {
 namespace multi {
@@ -29,9 +30,16 @@ class GenericMultipleBarcodeReader : public MultipleBarcodeReader {
   static Ref<Result> translateResultPoints(Ref<Result> result, 
                                            int xOffset, 
                                            int yOffset);
+  static bool getBounds(Ref<Result> result,
+                        float& minX,
+                        float& minY,
+                        float& maxX,
+                        float& maxY);
+  static bool isSameCode(Ref<Result> a, Ref<Result> b);
   void doDecodeMultiple(Ref<BinaryBitmap> image, 
                         DecodeHints hints, 
                         std::vector<Ref<Result> >& results, 
+                        std::set<std::vector<int> >& scanned,
                         int xOffset, 
                         int yOffset,
                         int currentDepth);
@@ -30,19 +30,11 @@ std::vector<Ref<Result> > QRCodeMultiReader::decodeMultiple(Ref<BinaryBitmap> im
   DecodeHints hints)
 {
   std::vector<Ref<Result> > results;
-  MultiDetector detector(image->getBlackMatrix());
 
-  std::vector<Ref<DetectorResult> > detectorResult =  detector.detectMulti(hints);
+  std::vector<Ref<DetectorResult> > detectorResult = detectMultiple(image, hints);
   for (unsigned int i = 0; i < detectorResult.size(); i++) {
     try {
-      Ref<DecoderResult> decoderResult = getDecoder().decode(detectorResult[i]->getBits());
-      ArrayRef< Ref<ResultPoint> > points = detectorResult[i]->getPoints();
-      Ref<Result> result = Ref<Result>(new Result(decoderResult->getText(),
-      decoderResult->getRawBytes(), 
-      points, BarcodeFormat::QR_CODE));
-      // result->putMetadata(ResultMetadataType.BYTE_SEGMENTS, decoderResult->getByteSegments());
-      // result->putMetadata(ResultMetadataType.ERROR_CORRECTION_LEVEL, decoderResult->getECLevel().toString());
-      results.push_back(result);
+      results.push_back(decodeDetected(detectorResult[i], hints));
     } catch (ReaderException const& re) {
       (void)re;
       // ignore and continue 
@@ -54,5 +46,25 @@ std::vector<Ref<Result> > QRCodeMultiReader::decodeMultiple(Ref<BinaryBitmap> im
   return results;
 }
 
+std::vector<Ref<DetectorResult> > QRCodeMultiReader::detectMultiple(Ref<BinaryBitmap> image,
+  DecodeHints hints)
+{
+  MultiDetector detector(image->getBlackMatrix());
+  return detector.detectMulti(hints);
+}
+
+Ref<Result> QRCodeMultiReader::decodeDetected(Ref<DetectorResult> detectorResult,
+  DecodeHints const& hints)
+{
+  Ref<DecoderResult> decoderResult = decodeBits(detectorResult->getBits(), hints);
+  ArrayRef< Ref<ResultPoint> > points = detectorResult->getPoints();
+  Ref<Result> result = Ref<Result>(new Result(decoderResult->getText(),
+  decoderResult->getRawBytes(), 
+  points, BarcodeFormat::QR_CODE));
+  // result->putMetadata(ResultMetadataType.BYTE_SEGMENTS, decoderResult->getByteSegments());
+  // result->putMetadata(ResultMetadataType.ERROR_CORRECTION_LEVEL, decoderResult->getECLevel().toString());
+  return result;
+}
+
 } // End zxing::multi namespace
 } // End zxing namespace
@@ -19,6 +19,7 @@
 
 #include <zxing/multi/MultipleBarcodeReader.h>
 #include <zxing/qrcode/QRCodeReader.h>
+#include <zxing/common/DetectorResult.h>
 
 namespace zxing {
 namespace multi {
@@ -28,6 +29,14 @@ class QRCodeMultiReader: public zxing::qrcode::QRCodeReader, public MultipleBarc
     QRCodeMultiReader();
     virtual ~QRCodeMultiReader();
     virtual std::vector<Ref<Result> > decodeMultiple(Ref<BinaryBitmap> image, DecodeHints hints);
+
+    /**
+     * The two halves of decodeMultiple(): finding and sampling every candidate
+     * symbol, then decoding one of them. Candidates can be decoded on separate
+     * threads as long as each thread uses its own reader.
+     */
+    std::vector<Ref<DetectorResult> > detectMultiple(Ref<BinaryBitmap> image, DecodeHints hints);
+    Ref<Result> decodeDetected(Ref<DetectorResult> detectorResult, DecodeHints const& hints);
 };
 
 }
@@ -16,7 +16,6 @@
  */
 
 #include <stdint.h>
-#include <bigint/BigIntegerUtils.hh>
 #include <zxing/FormatException.h>
 #include <zxing/pdf417/decoder/DecodedBitStreamParser.h>
 #include <zxing/common/DecoderResult.h>
@@ -46,8 +45,6 @@ const int DecodedBitStreamParser::AL = 28;
 const int DecodedBitStreamParser::PS = 29;
 const int DecodedBitStreamParser::PAL = 29;
 
-const int DecodedBitStreamParser::EXP900_SIZE = 16;
-
 const char DecodedBitStreamParser::PUNCT_CHARS[] = {
   ';', '<', '>', '@', '[', '\\', '}', '_', '`', '~', '!',
   '\r', '\t', ',', ':', '\n', '-', '.', '$', '/', '"', '|', '*',
@@ -58,19 +55,6 @@ const char DecodedBitStreamParser::MIXED_CHARS[] = {
   '\r', '\t', ',', ':', '#', '-', '.', '$', '/', '+', '%', '*',
   '=', '^'};
 
-ArrayRef<BigInteger> DecodedBitStreamParser::initEXP900() {
-  ArrayRef<BigInteger> EXP900 (16);
-  EXP900[0] = BigInteger(1);
-  BigInteger nineHundred (900);
-  EXP900[1] = nineHundred;
-  for (int i = 2; i < EXP900->size(); i++) {
-    EXP900[i] = EXP900[i - 1] * nineHundred;
-  }
-  return EXP900;
-}
-
-ArrayRef<BigInteger> DecodedBitStreamParser::EXP900 = initEXP900();
-
 DecodedBitStreamParser::DecodedBitStreamParser(){}
 
 /**
@@ -548,16 +532,38 @@ int DecodedBitStreamParser::numericCompaction(ArrayRef<int> codewords,
 */
 Ref<String> DecodedBitStreamParser::decodeBase900toBase10(ArrayRef<int> codewords, int count)
 {
-  BigInteger result = BigInteger(0);
+  // A full group is below 900^15 < 10^45, so five base 10^9 limbs hold it.
+  // Horner's rule keeps every step within 64 bits: limb * 900 + carry.
+  const uint32_t LIMB_BASE = 1000000000;
+  const int LIMBS = 5;
+  if (count > MAX_NUMERIC_CODEWORDS) {
+    throw FormatException("DecodedBitStreamParser::decodeBase900toBase10: too many codewords");
+  }
+  uint32_t limbs[LIMBS] = {0, 0, 0, 0, 0};  // least significant first
   for (int i = 0; i < count; i++) {
-    result = result + (EXP900[count - i - 1] * BigInteger(codewords[i]));
+    uint64_t carry = codewords[i];
+    for (int j = 0; j < LIMBS; j++) {
+      uint64_t value = (uint64_t) limbs[j] * 900 + carry;
+      limbs[j] = (uint32_t) (value % LIMB_BASE);
+      carry = value / LIMB_BASE;
+    }
+  }
+
+  char digits[LIMBS * 9];
+  for (int j = 0; j < LIMBS; j++) {
+    uint32_t limb = limbs[j];
+    for (int k = 0; k < 9; k++) {
+      digits[LIMBS * 9 - 1 - (j * 9 + k)] = (char) ('0' + limb % 10);
+      limb /= 10;
+    }
+  }
+  int first = 0;
+  while (first < LIMBS * 9 - 1 && digits[first] == '0') {
+    first++;
   }
-  string resultString = bigIntegerToString(result);
-  if (resultString[0] != '1') {
+  if (digits[first] != '1') {
     throw FormatException("DecodedBitStreamParser::decodeBase900toBase10: String does not begin with 1");
   }
-  string resultString2;
-  resultString2.assign(resultString.begin()+1,resultString.end());
-  Ref<String> res (new String(resultString2));
+  Ref<String> res (new String(string(digits + first + 1, digits + LIMBS * 9)));
   return res;
 }
@@ -18,16 +18,95 @@
  */
 
 #include <zxing/pdf417/decoder/ec/ErrorCorrection.h>
-#include <zxing/pdf417/decoder/ec/ModulusPoly.h>
 #include <zxing/pdf417/decoder/ec/ModulusGF.h>
 
-using std::vector;
-using zxing::Ref;
+#include <algorithm>
+
 using zxing::ArrayRef;
 using zxing::pdf417::decoder::ec::ErrorCorrection;
-using zxing::pdf417::decoder::ec::ModulusPoly;
 using zxing::pdf417::decoder::ec::ModulusGF;
 
+namespace {
+
+// ModulusGF::PDF417_GF is GF(929); keeping the modulus a compile time
+// constant lets the compiler reduce products with a multiply and shift
+// instead of a division.
+const int MODULUS = 929;
+
+// Same limit as pdf417::decoder::Decoder::MAX_EC_CODEWORDS.
+const int MAX_EC_CODEWORDS = 512;
+
+// Number of points evaluated together.
+const int POINTS = 8;
+
+inline int multiply(int a, int b) {
+  return a * b % MODULUS;
+}
+
+}
+
+struct ErrorCorrection::Poly {
+  // coefficients[i] is the coefficient of x^i; the zero polynomial has
+  // degree 0.
+  int degree;
+  int coefficients[MAX_EC_CODEWORDS + 1];
+
+  void setMonomial(int d, int coefficient) {
+    degree = d;
+    std::fill(coefficients, coefficients + d, 0);
+    coefficients[d] = coefficient;
+  }
+
+  bool isZero() const {
+    return degree == 0 && coefficients[0] == 0;
+  }
+
+  void trim() {
+    while (degree > 0 && coefficients[degree] == 0) {
+      degree--;
+    }
+  }
+
+  int evaluateAt(int a) const {
+    int result = coefficients[degree];
+    for (int i = degree - 1; i >= 0; i--) {
+      result = (result * a + coefficients[i]) % MODULUS;
+    }
+    return result;
+  }
+
+  void evaluateAt(const int a[POINTS], int result[POINTS]) const {
+    for (int k = 0; k < POINTS; k++) {
+      result[k] = coefficients[degree];
+    }
+    for (int i = degree - 1; i >= 0; i--) {
+      for (int k = 0; k < POINTS; k++) {
+        result[k] = (result[k] * a[k] + coefficients[i]) % MODULUS;
+      }
+    }
+  }
+
+  void scale(int scalar) {
+    for (int i = 0; i <= degree; i++) {
+      coefficients[i] = multiply(coefficients[i], scalar);
+    }
+  }
+
+  /** this -= factor * x^shift * other */
+  void subtractMultiple(const Poly& other, int shift, int factor) {
+    int top = other.degree + shift;
+    if (top > degree) {
+      std::fill(coefficients + degree + 1, coefficients + top + 1, 0);
+      degree = top;
+    }
+    int negated = MODULUS - factor;
+    for (int i = 0; i <= other.degree; i++) {
+      coefficients[i + shift] = (coefficients[i + shift] + negated * other.coefficients[i]) % MODULUS;
+    }
+    trim();
+  }
+};
+
 /**
  * <p>PDF417 error correction implementation.</p>
  *
@@ -48,45 +127,56 @@ void ErrorCorrection::decode(ArrayRef<int> received,
                              int numECCodewords,
                              ArrayRef<int> erasures)
 {
-  Ref<ModulusPoly> poly (new ModulusPoly(field_, received));
-  ArrayRef<int> S( new Array<int>(numECCodewords));
+  if (numECCodewords < 0 || numECCodewords > MAX_EC_CODEWORDS) {
+    throw ReedSolomonException("Too many EC codewords!");
+  }
+
+  // The syndrome S(x) has received(3^(i+1)) as its x^i coefficient.
+  // Unreadable codewords may come in as -1, which is 928 in the field.
+  // Several points are evaluated per pass so that the Horner chains overlap.
+  int size = received->size();
+  const int* codewords = received->values().data();
+  Poly a, b;
   bool error = false;
-  for (int i = numECCodewords; i > 0; i--) {
-    int eval = poly->evaluateAt(field_.exp(i));
-    S[numECCodewords - i] = eval;
-    if (eval != 0) {
-      error = true;
+  for (int i = 0; i < numECCodewords; i += POINTS) {
+    int x[POINTS], eval[POINTS];
+    for (int k = 0; k < POINTS; k++) {
+      x[k] = field_.exp(i + k + 1);
+      eval[k] = 0;
+    }
+    for (int j = 0; j < size; j++) {
+      int c = codewords[j] + MODULUS;
+      for (int k = 0; k < POINTS; k++) {
+        eval[k] = (eval[k] * x[k] + c) % MODULUS;
+      }
+    }
+    for (int k = 0; k < POINTS && i + k < numECCodewords; k++) {
+      b.coefficients[i + k] = eval[k];
+      if (eval[k] != 0) {
+        error = true;
+      }
     }
   }
 
   if (error) {
+    // Erasure positions are not used to seed the error locator; erased
+    // codewords are found and corrected like any other error.
+    (void)erasures;
 
-    Ref<ModulusPoly> knownErrors = field_.getOne();
-    for (int i=0;i<erasures->size();i++) {
-      int b = field_.exp(received->size() - 1 - erasures[i]);
-      // Add (1 - bx) term:
-      ArrayRef<int> one_minus_b_x(new Array<int>(2));
-      one_minus_b_x[1]=field_.subtract(0,b);
-      one_minus_b_x[0]=1;
-      Ref<ModulusPoly> term (new ModulusPoly(field_,one_minus_b_x));
-      knownErrors = knownErrors->multiply(term);
-    }
+    a.setMonomial(numECCodewords, 1);
+    b.degree = numECCodewords - 1;
+    b.trim();
 
-    Ref<ModulusPoly> syndrome (new ModulusPoly(field_, S));
-    //syndrome = syndrome.multiply(knownErrors);
+    Poly sigma, omega;
+    runEuclideanAlgorithm(a, b, numECCodewords, sigma, omega);
 
-    vector<Ref<ModulusPoly> > sigmaOmega (
-        runEuclideanAlgorithm(field_.buildMonomial(numECCodewords, 1), syndrome, numECCodewords));
-    Ref<ModulusPoly> sigma = sigmaOmega[0];
-    Ref<ModulusPoly> omega = sigmaOmega[1];
+    int errorLocations[MAX_EC_CODEWORDS];
+    int errorMagnitudes[MAX_EC_CODEWORDS];
+    int numErrors = findErrorLocations(sigma, errorLocations);
+    findErrorMagnitudes(omega, sigma, errorLocations, numErrors, errorMagnitudes);
 
-    //sigma = sigma.multiply(knownErrors);
-
-    ArrayRef<int> errorLocations = findErrorLocations(sigma);
-    ArrayRef<int> errorMagnitudes = findErrorMagnitudes(omega, sigma, errorLocations);
-
-    for (int i = 0; i < errorLocations->size(); i++) {
-      int position = received->size() - 1 - field_.log(errorLocations[i]);
+    for (int i = 0; i < numErrors; i++) {
+      int position = size - 1 - field_.log(errorLocations[i]);
       if (position < 0) {
         throw ReedSolomonException("Bad error location!");
       }
@@ -103,69 +193,71 @@ void ErrorCorrection::decode(ArrayRef<int> received,
   }
 }
 
-vector<Ref<ModulusPoly> >  ErrorCorrection::runEuclideanAlgorithm(Ref<ModulusPoly> a, Ref<ModulusPoly> b, int R)
+/**
+ * Runs the extended Euclidean algorithm on a = x^R and b = S(x). a and b
+ * are used as the remainder buffers and end up clobbered.
+ */
+void ErrorCorrection::runEuclideanAlgorithm(Poly& a, Poly& b, int R, Poly& sigma, Poly& omega)
 {
-  // Assume a's degree is >= b's
-  if (a->getDegree() < b->getDegree()) {
-    Ref<ModulusPoly> temp = a;
-    a = b;
-    b = temp;
-  }
-
-  Ref<ModulusPoly> rLast ( a);
-  Ref<ModulusPoly> r ( b);
-  Ref<ModulusPoly> tLast ( field_.getZero());
-  Ref<ModulusPoly> t ( field_.getOne());
+  Poly* rLast = &a;
+  Poly* r = &b;
+  Poly* tLast = &sigma;
+  Poly* t = &omega;
+  tLast->setMonomial(0, 0);
+  t->setMonomial(0, 1);
 
   // Run Euclidean algorithm until r's degree is less than R/2
-  while (r->getDegree() >= R / 2) {
-    Ref<ModulusPoly> rLastLast (rLast);
-    Ref<ModulusPoly> tLastLast (tLast);
-    rLast = r;
-    tLast = t;
+  while (r->degree >= R / 2) {
+    // rLastLast and tLastLast take over the buffers of the values being
+    // replaced, and are then turned into the new r and t in place
+    std::swap(rLast, r);
+    std::swap(tLast, t);
 
-    // Divide rLastLast by rLast, with quotient in q and remainder in r
     if (rLast->isZero()) {
       // Oops, Euclidean algorithm already terminated?
       throw ReedSolomonException("Euclidean algorithm already terminated?");
     }
-    r = rLastLast;
-    Ref<ModulusPoly> q (field_.getZero());
-    int denominatorLeadingTerm = rLast->getCoefficient(rLast->getDegree());
-    int dltInverse = field_.inverse(denominatorLeadingTerm);
-    while (r->getDegree() >= rLast->getDegree() && !r->isZero()) {
-      int degreeDiff = r->getDegree() - rLast->getDegree();
-      int scale = field_.multiply(r->getCoefficient(r->getDegree()), dltInverse);
-      q = q->add(field_.buildMonomial(degreeDiff, scale));
-      r = r->subtract(rLast->multiplyByMonomial(degreeDiff, scale));
+    int dltInverse = field_.inverse(rLast->coefficients[rLast->degree]);
+    // Divide rLastLast by rLast, leaving the remainder in r; each quotient
+    // term q_i x^i is folded straight into t = tLastLast - q * tLast
+    while (r->degree >= rLast->degree && !r->isZero()) {
+      int degreeDiff = r->degree - rLast->degree;
+      int scale = multiply(r->coefficients[r->degree], dltInverse);
+      r->subtractMultiple(*rLast, degreeDiff, scale);
+      t->subtractMultiple(*tLast, degreeDiff, scale);
     }
-
-	  t = q->multiply(tLast)->subtract(tLastLast)->negative();
   }
 
-  int sigmaTildeAtZero = t->getCoefficient(0);
+  int sigmaTildeAtZero = t->coefficients[0];
   if (sigmaTildeAtZero == 0) {
     throw ReedSolomonException("sigmaTilde = 0!");
   }
 
   int inverse = field_.inverse(sigmaTildeAtZero);
-  Ref<ModulusPoly> sigma (t->multiply(inverse));
-  Ref<ModulusPoly> omega (r->multiply(inverse));
-	vector<Ref<ModulusPoly> > v(2);
-	v[0] = sigma;
-	v[1] = omega;
-  return v;
+  t->scale(inverse);
+  r->scale(inverse);
+  if (t != &sigma) {
+    // t sits in omega's buffer and tLast, no longer needed, in sigma's
+    sigma = *t;
+  }
+  omega = *r;
 }
 
-ArrayRef<int> ErrorCorrection::findErrorLocations(Ref<ModulusPoly> errorLocator)  {
+int ErrorCorrection::findErrorLocations(const Poly& errorLocator, int errorLocations[]) {
   // This is a direct application of Chien's search
-  int numErrors = errorLocator->getDegree();
-  ArrayRef<int> result( new Array<int>(numErrors));
+  int numErrors = errorLocator.degree;
   int e = 0;
-  for (int i = 1; i < field_.getSize() && e < numErrors; i++) {
-    if (errorLocator->evaluateAt(i) == 0) {
-      result[e] = field_.inverse(i);
-      e++;
+  for (int i = 1; i < MODULUS && e < numErrors; i += POINTS) {
+    int x[POINTS], eval[POINTS];
+    for (int k = 0; k < POINTS; k++) {
+      x[k] = i + k;
+    }
+    errorLocator.evaluateAt(x, eval);
+    for (int k = 0; k < POINTS && x[k] < MODULUS && e < numErrors; k++) {
+      if (eval[k] == 0) {
+        errorLocations[e] = field_.inverse(x[k]);
+        e++;
+      }
     }
   }
   if (e != numErrors) {
@@ -185,30 +277,29 @@ ArrayRef<int> ErrorCorrection::findErrorLocations(Ref<ModulusPoly> errorLocator)
     OutputDebugString(szmsg);
   }
 #endif
-  return result;
+  return numErrors;
 }
 
-ArrayRef<int> ErrorCorrection::findErrorMagnitudes(Ref<ModulusPoly> errorEvaluator,
-                                                   Ref<ModulusPoly> errorLocator,
-                                                   ArrayRef<int> errorLocations) {
-	int i;
-  int errorLocatorDegree = errorLocator->getDegree();
-  ArrayRef<int> formalDerivativeCoefficients (new Array<int>(errorLocatorDegree));
-  for (i = 1; i <= errorLocatorDegree; i++) {
-    formalDerivativeCoefficients[errorLocatorDegree - i] =
-        field_.multiply(i, errorLocator->getCoefficient(i));
+void ErrorCorrection::findErrorMagnitudes(const Poly& errorEvaluator,
+                                          const Poly& errorLocator,
+                                          const int errorLocations[],
+                                          int numErrors,
+                                          int errorMagnitudes[]) {
+  int errorLocatorDegree = errorLocator.degree;
+  if (errorLocatorDegree == 0) {
+    throw ReedSolomonException("Error locator has no roots!");
+  }
+  Poly formalDerivative;
+  formalDerivative.degree = errorLocatorDegree - 1;
+  for (int i = 1; i <= errorLocatorDegree; i++) {
+    formalDerivative.coefficients[i - 1] = multiply(i, errorLocator.coefficients[i]);
   }
-  Ref<ModulusPoly> formalDerivative (new ModulusPoly(field_, formalDerivativeCoefficients));
 
   // This is directly applying Forney's Formula
-  int s = errorLocations->size();
-  ArrayRef<int> result ( new Array<int>(s));
-  for (i = 0; i < s; i++) {
+  for (int i = 0; i < numErrors; i++) {
     int xiInverse = field_.inverse(errorLocations[i]);
-    int numerator = field_.subtract(0, errorEvaluator->evaluateAt(xiInverse));
-    int denominator = field_.inverse(formalDerivative->evaluateAt(xiInverse));
-    result[i] = field_.multiply(numerator, denominator);
+    int numerator = (MODULUS - errorEvaluator.evaluateAt(xiInverse)) % MODULUS;
+    int denominator = field_.inverse(formalDerivative.evaluateAt(xiInverse));
+    errorMagnitudes[i] = multiply(numerator, denominator);
   }
-  return result;
 }
-
@@ -25,7 +25,6 @@
 #include <zxing/common/DecoderResult.h>
 #include <zxing/common/BitMatrix.h>
 #include <zxing/pdf417/decoder/ec/ModulusGF.h>
-#include <zxing/pdf417/decoder/ec/ModulusPoly.h>
 #include <zxing/common/reedsolomon/ReedSolomonException.h>
 
 namespace zxing {
@@ -55,12 +54,20 @@ class ErrorCorrection: public Counted {
               ArrayRef<int> erasures);
 
  private:
-  std::vector<Ref<ModulusPoly> > runEuclideanAlgorithm(Ref<ModulusPoly> a, Ref<ModulusPoly> b, int R);
+  /**
+   * Polynomial over GF(929) in a fixed buffer large enough for the
+   * largest number of EC codewords; all decoding work is done in place.
+   */
+  struct Poly;
 
-  ArrayRef<int> findErrorLocations(Ref<ModulusPoly> errorLocator);
-  ArrayRef<int> findErrorMagnitudes(Ref<ModulusPoly> errorEvaluator,
-                                    Ref<ModulusPoly> errorLocator,
-                                    ArrayRef<int> errorLocations);
+  void runEuclideanAlgorithm(Poly& a, Poly& b, int R, Poly& sigma, Poly& omega);
+
+  int findErrorLocations(const Poly& errorLocator, int errorLocations[]);
+  void findErrorMagnitudes(const Poly& errorEvaluator,
+                           const Poly& errorLocator,
+                           const int errorLocations[],
+                           int numErrors,
+                           int errorMagnitudes[]);
 };
 
 }
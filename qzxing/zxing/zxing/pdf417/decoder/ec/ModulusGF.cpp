@@ -18,11 +18,8 @@
  */
 
 #include <zxing/pdf417/decoder/ec/ModulusGF.h>
-#include <zxing/pdf417/decoder/ec/ModulusPoly.h>
 
-using zxing::Ref;
 using zxing::pdf417::decoder::ec::ModulusGF;
-using zxing::pdf417::decoder::ec::ModulusPoly;
 
 /**
  * The central Modulus Galois Field for PDF417 with prime number 929
@@ -51,36 +48,7 @@ ModulusGF::ModulusGF(int modulus, int generator)
     logTable_[expTable_[i]] = i;
   }
   // logTable[0] == 0 but this should never be used
-	ArrayRef<int>aZero(new Array<int>(1)),aOne(new Array<int>(1));
-	aZero[0]=0;aOne[0]=1;
-  zero_ = new ModulusPoly(*this, aZero);
-  one_ = new ModulusPoly(*this, aOne);
 }
- 
-Ref<ModulusPoly> ModulusGF::getZero() {
-  return zero_;
-}
-
-Ref<ModulusPoly> ModulusGF::getOne() {
-  return one_;
-}
-
-Ref<ModulusPoly> ModulusGF::buildMonomial(int degree, int coefficient)
-{
-  if (degree < 0) {
-    throw IllegalArgumentException("monomial: degree < 0!");
-  }
-  if (coefficient == 0) {
-    return zero_;
-  }
-	int nCoefficients = degree + 1;
-  ArrayRef<int> coefficients (new Array<int>(nCoefficients));
-  coefficients[0] = coefficient;
-	Ref<ModulusPoly> result(new ModulusPoly(*this,coefficients));
-  return result;
-}
-
- 
 
 int ModulusGF::add(int a, int b) {
   return (a + b) % modulus_;
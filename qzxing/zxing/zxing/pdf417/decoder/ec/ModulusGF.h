@@ -28,8 +28,6 @@ namespace pdf417 {
 namespace decoder {
 namespace ec {
 
-class ModulusPoly;
-
 /**
  * <p>A field based on powers of a generator integer, modulo some modulus.</p>
  *
@@ -44,15 +42,10 @@ class ModulusGF {
   private:
 	ArrayRef<int> expTable_;
 	ArrayRef<int> logTable_;
-	Ref<ModulusPoly> zero_;
-	Ref<ModulusPoly> one_;
 	int modulus_;
 
   public:
 	ModulusGF(int modulus, int generator);
-	Ref<ModulusPoly> getZero();
-	Ref<ModulusPoly> getOne();
-	Ref<ModulusPoly> buildMonomial(int degree, int coefficient);
 
 	int add(int a, int b);
 	int subtract(int a, int b);
@@ -51,16 +51,25 @@ private:
   static ArrayRef< Ref<ResultPoint> > findVertices(Ref<BitMatrix> matrix, int rowStep);
   static ArrayRef< Ref<ResultPoint> > findVertices180(Ref<BitMatrix> matrix, int rowStep);
 
-  static ArrayRef<int> findGuardPattern(Ref<BitMatrix> matrix,
-                                        int column,
-                                        int row,
-                                        int width,
-                                        bool whiteFirst,
-                                        const int pattern[],
-                                        int patternSize,
-                                        ArrayRef<int>& counters);
-  static int patternMatchVariance(ArrayRef<int>& counters, const int pattern[],
-                                  int maxIndividualVariance);
+  static int findGuardRow(Ref<BitMatrix> const& matrix,
+                          int firstRow,
+                          int rowStep,
+                          int column,
+                          int width,
+                          bool whiteFirst,
+                          const int pattern[],
+                          int patternSize,
+                          int loc[2]);
+  static bool findGuardPattern(Ref<BitMatrix> const& matrix,
+                               int column,
+                               int row,
+                               int width,
+                               bool whiteFirst,
+                               const int pattern[],
+                               int patternSize,
+                               int loc[2]);
+  static int patternMatchVariance(const int counters[], const int pattern[],
+                                  int patternSize, int maxIndividualVariance);
 
   static void correctVertices(Ref<BitMatrix> matrix,
                               ArrayRef< Ref<ResultPoint> >& vertices,
@@ -15,15 +15,15 @@
  * limitations under the License.
  */
 
-#include <map>
 #include <zxing/pdf417/detector/LinesSampler.h>
 #include <zxing/pdf417/decoder/BitMatrixParser.h>
 #include <zxing/NotFoundException.h>
 #include <zxing/common/Point.h>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <qglobal.h>
 
-using std::map;
 using std::vector;
 using std::min;
 using std::abs;
@@ -66,53 +66,233 @@ class VoteResult {
     this->vote = vote;
   }
 };
-  
-VoteResult getValueWithMaxVotes(map<int, int>& votes) {
+
+/**
+ * votes[i] counts the votes for value i. Values are visited in ascending
+ * order, so a tie keeps the smallest value but is reported as indecisive.
+ */
+VoteResult getValueWithMaxVotes(const int votes[], int size) {
   VoteResult result;
   int maxVotes = 0;
-  for (map<int, int>::iterator i = votes.begin(); i != votes.end(); i++) {
-    if (i->second > maxVotes) {
-      maxVotes = i->second;
-      result.setVote(i->first);
+  for (int i = 0; i < size; i++) {
+    if (votes[i] == 0) {
+      continue;
+    }
+    if (votes[i] > maxVotes) {
+      maxVotes = votes[i];
+      result.setVote(i);
       result.setIndecisive(false);
-    } else if (i->second == maxVotes) {
+    } else if (votes[i] == maxVotes) {
       result.setIndecisive(true);
     }
   }
   return result;
 }
 
-}
+/**
+ * Votes for the symbol read at each position of the codeword grid. A position
+ * rarely sees more than a couple of different readings, so each keeps a few
+ * counters of its own; further readings spill into a list shared by the grid.
+ */
+class VoteGrid {
+ private:
+  static const int SLOTS = 4;
+
+  struct Cell {
+    int symbols[SLOTS];
+    int votes[SLOTS];
+  };
+  struct Spill {
+    int cell;
+    int symbol;
+    int votes;
+  };
+
+  int columns_;
+  vector<Cell> cells_;
+  vector<Spill> spill_;
+
+ public:
+  VoteGrid(int columns) : columns_(columns) {
+  }
 
-vector<float> LinesSampler::init_ratios_table() {
-  // Pre-computes and outputs the symbol ratio table.
-  vector<vector<float> > table (BitMatrixParser::SYMBOL_TABLE_LENGTH);
-  for(int i=0; i < (int)table.size(); ++i) {
-    table[i].resize(LinesSampler::BARS_IN_SYMBOL);
+  int getRows() const {
+    return (int)cells_.size() / columns_;
   }
-  vector<float> RATIOS_TABLE (BitMatrixParser::SYMBOL_TABLE_LENGTH * LinesSampler::BARS_IN_SYMBOL);
-  int x = 0;
-  for (int i = 0; i < BitMatrixParser::SYMBOL_TABLE_LENGTH; i++) {
-    int currentSymbol = BitMatrixParser::SYMBOL_TABLE[i];
-    int currentBit = currentSymbol & 0x1;
-    for (int j = 0; j < BARS_IN_SYMBOL; j++) {
-      float size = 0.0f;
-      while ((currentSymbol & 0x1) == currentBit) {
-        size += 1.0f;
-        currentSymbol >>= 1;
-      }
-      currentBit = currentSymbol & 0x1;
-      table[i][BARS_IN_SYMBOL - j - 1] = size / MODULES_IN_SYMBOL;
-    }
-    for (int j = 0; j < BARS_IN_SYMBOL; j++) {
-      RATIOS_TABLE[x] = table[i][j];
-      x++;
+
+  void ensureRows(int rows) {
+    if (getRows() < rows) {
+      Cell empty = {{0}, {0}};
+      cells_.resize(rows * columns_, empty);
+    }
+  }
+
+  void vote(int row, int column, int symbol) {
+    int index = row * columns_ + column;
+    Cell &cell = cells_[index];
+    for (int i = 0; i < SLOTS; i++) {
+      if (cell.votes[i] == 0) {
+        cell.symbols[i] = symbol;
+        cell.votes[i] = 1;
+        return;
+      }
+      if (cell.symbols[i] == symbol) {
+        cell.votes[i]++;
+        return;
+      }
+    }
+    for (int i = 0; i < (int)spill_.size(); i++) {
+      if (spill_[i].cell == index && spill_[i].symbol == symbol) {
+        spill_[i].votes++;
+        return;
+      }
     }
+    Spill spill = {index, symbol, 1};
+    spill_.push_back(spill);
   }
-  return RATIOS_TABLE;
+
+  /**
+   * @return the symbol with the most votes, the smallest one on a tie, or 0
+   *         if nothing was read at this position.
+   */
+  int getWinner(int row, int column) const {
+    int index = row * columns_ + column;
+    const Cell &cell = cells_[index];
+    int winner = 0;
+    int maxVotes = 0;
+    for (int i = 0; i < SLOTS && cell.votes[i] > 0; i++) {
+      if (cell.votes[i] > maxVotes || (cell.votes[i] == maxVotes && cell.symbols[i] < winner)) {
+        maxVotes = cell.votes[i];
+        winner = cell.symbols[i];
+      }
+    }
+    if (cell.votes[SLOTS - 1] > 0) {
+      for (int i = 0; i < (int)spill_.size(); i++) {
+        const Spill &spill = spill_[i];
+        if (spill.cell == index &&
+            (spill.votes > maxVotes || (spill.votes == maxVotes && spill.symbol < winner))) {
+          maxVotes = spill.votes;
+          winner = spill.symbol;
+        }
+      }
+    }
+    return winner;
+  }
+};
+
 }
 
-const vector<float> LinesSampler::RATIOS_TABLE = init_ratios_table();
+struct LinesSampler::SymbolIndex {
+  // Bar widths run from 1 to 6 modules
+  static const int MAX_BAR_WIDTH = 6;
+  static const int GROUPS = MAX_BAR_WIDTH * MAX_BAR_WIDTH;
+  static const float WIDTH_RATIOS[MAX_BAR_WIDTH + 1];
+
+  // Indices into SYMBOL_TABLE, ordered by group and ascending within a group
+  int symbols[POSSIBLE_SYMBOLS];
+  unsigned char widths[POSSIBLE_SYMBOLS][BARS_IN_SYMBOL];
+  int groupStart[GROUPS + 1];
+
+  static int getGroup(int firstWidth, int secondWidth) {
+    return (firstWidth - 1) * MAX_BAR_WIDTH + secondWidth - 1;
+  }
+
+  static int nearestWidth(float ratio) {
+    int width = (int)(ratio * MODULES_IN_SYMBOL + 0.5f);
+    return width < 1 ? 1 : width > MAX_BAR_WIDTH ? MAX_BAR_WIDTH : width;
+  }
+
+  SymbolIndex() {
+    unsigned char symbolWidths[POSSIBLE_SYMBOLS][BARS_IN_SYMBOL];
+    int groupSize[GROUPS] = {0};
+    for (int i = 0; i < POSSIBLE_SYMBOLS; i++) {
+      int currentSymbol = BitMatrixParser::SYMBOL_TABLE[i];
+      int currentBit = currentSymbol & 0x1;
+      for (int j = 0; j < BARS_IN_SYMBOL; j++) {
+        int size = 0;
+        while ((currentSymbol & 0x1) == currentBit) {
+          size++;
+          currentSymbol >>= 1;
+        }
+        currentBit = currentSymbol & 0x1;
+        symbolWidths[i][BARS_IN_SYMBOL - j - 1] = (unsigned char)size;
+      }
+      groupSize[getGroup(symbolWidths[i][0], symbolWidths[i][1])]++;
+    }
+    groupStart[0] = 0;
+    for (int g = 0; g < GROUPS; g++) {
+      groupStart[g + 1] = groupStart[g] + groupSize[g];
+      groupSize[g] = groupStart[g];
+    }
+    for (int i = 0; i < POSSIBLE_SYMBOLS; i++) {
+      int position = groupSize[getGroup(symbolWidths[i][0], symbolWidths[i][1])]++;
+      symbols[position] = i;
+      for (int j = 0; j < BARS_IN_SYMBOL; j++) {
+        widths[position][j] = symbolWidths[i][j];
+      }
+    }
+  }
+
+  /**
+   * Finds the symbol whose bar ratios are closest to the given ones, by the
+   * sum of squared differences, the lowest SYMBOL_TABLE index winning a tie.
+   * The group nearest the measured widths is tried first; after that, a group
+   * whose first two bars already differ by more than the best match is skipped.
+   *
+   * @return the index into SYMBOL_TABLE, or -1 if no error was finite.
+   */
+  int findClosest(const float ratios[]) const {
+    float firstErrors[MAX_BAR_WIDTH];
+    float secondErrors[MAX_BAR_WIDTH];
+    for (int w = 0; w < MAX_BAR_WIDTH; w++) {
+      float diff = WIDTH_RATIOS[w + 1] - ratios[0];
+      firstErrors[w] = diff * diff;
+      diff = WIDTH_RATIOS[w + 1] - ratios[1];
+      secondErrors[w] = diff * diff;
+    }
+
+    float bestError = std::numeric_limits<float>::max();
+    int bestIndex = -1;
+    int nearestGroup = getGroup(nearestWidth(ratios[0]), nearestWidth(ratios[1]));
+    for (int n = -1; n < GROUPS; n++) {
+      int g = n < 0 ? nearestGroup : n;
+      if (n == nearestGroup) {
+        continue;
+      }
+      float groupError = firstErrors[g / MAX_BAR_WIDTH];
+      groupError += secondErrors[g % MAX_BAR_WIDTH];
+      if (groupError > bestError) {
+        continue;
+      }
+      for (int position = groupStart[g]; position < groupStart[g + 1]; position++) {
+        const unsigned char *symbolWidths = widths[position];
+        float error = groupError;
+        for (int k = 2; k < BARS_IN_SYMBOL && error <= bestError; k++) {
+          float diff = WIDTH_RATIOS[symbolWidths[k]] - ratios[k];
+          error += diff * diff;
+        }
+        int index = symbols[position];
+        if (error < bestError || (error == bestError && index < bestIndex)) {
+          bestError = error;
+          bestIndex = index;
+        }
+      }
+    }
+    return bestIndex;
+  }
+};
+
+const float LinesSampler::SymbolIndex::WIDTH_RATIOS[] = {
+  0.0f,
+  1.0f / MODULES_IN_SYMBOL,
+  2.0f / MODULES_IN_SYMBOL,
+  3.0f / MODULES_IN_SYMBOL,
+  4.0f / MODULES_IN_SYMBOL,
+  5.0f / MODULES_IN_SYMBOL,
+  6.0f / MODULES_IN_SYMBOL
+};
+
+const LinesSampler::SymbolIndex LinesSampler::SYMBOL_INDEX;
 
 LinesSampler::LinesSampler(Ref<BitMatrix> linesMatrix, int dimension)
     : linesMatrix_(linesMatrix), dimension_(dimension) {}
@@ -120,45 +300,41 @@ LinesSampler::LinesSampler(Ref<BitMatrix> linesMatrix, int dimension)
 /**
  * Samples a grid from a lines matrix.
  *
+ * The codewords read from each line, their cluster numbers and the grid that
+ * the votes settle on are all kept row-major in flat vectors, symbolsPerLine
+ * entries per row.
+ *
  * @return the potentially decodable bit matrix.
  */
 Ref<BitMatrix> LinesSampler::sample() {
   const int symbolsPerLine = dimension_ / MODULES_IN_SYMBOL;
+  if (symbolsPerLine < 1) {
+    throw NotFoundException("No symbols in this line.");
+  }
 
   // XXX
   vector<float> symbolWidths;
   computeSymbolWidths(symbolWidths, symbolsPerLine, linesMatrix_);
 
   // XXX
-  vector<vector<int> > codewords(linesMatrix_->getHeight());
-  vector<vector<int> > clusterNumbers(linesMatrix_->getHeight());
+  vector<int> codewords(linesMatrix_->getHeight() * symbolsPerLine, 0);
+  vector<int> clusterNumbers(linesMatrix_->getHeight() * symbolsPerLine, -1);
   linesMatrixToCodewords(clusterNumbers, symbolsPerLine, symbolWidths, linesMatrix_, codewords);
 
   // XXX
-  vector<vector<map<int, int> > > votes =
-      distributeVotes(symbolsPerLine, codewords, clusterNumbers);
-
-  // XXX
-  vector<vector<int> > detectedCodeWords(votes.size());
-  for (int i = 0; i < (int)votes.size(); i++) {
-    detectedCodeWords[i].resize(votes[i].size(), 0);
-    for (int j = 0; j < (int)votes[i].size(); j++) {
-      if (!votes[i][j].empty()) {
-        detectedCodeWords[i][j] = getValueWithMaxVotes(votes[i][j]).getVote();
-      }
-    }
-  }
+  vector<int> detectedCodeWords;
+  distributeVotes(symbolsPerLine, codewords, clusterNumbers, detectedCodeWords);
 
   // XXX
   vector<int> insertLinesAt = findMissingLines(symbolsPerLine, detectedCodeWords);
 
   // XXX
   int rowCount = decodeRowCount(symbolsPerLine, detectedCodeWords, insertLinesAt);
-  detectedCodeWords.resize(rowCount);
+  detectedCodeWords.resize(rowCount * symbolsPerLine, 0);
 
   // XXX
-  Ref<BitMatrix> grid(new BitMatrix(dimension_, detectedCodeWords.size()));
-  codewordsToBitMatrix(detectedCodeWords, grid);
+  Ref<BitMatrix> grid(new BitMatrix(dimension_, rowCount));
+  codewordsToBitMatrix(detectedCodeWords, symbolsPerLine, grid);
 
   return grid;
 }
@@ -166,16 +342,21 @@ Ref<BitMatrix> LinesSampler::sample() {
 /**
  * @brief LinesSampler::codewordsToBitMatrix
  * @param codewords
+ * @param symbolsPerLine
  * @param matrix
  */
-void LinesSampler::codewordsToBitMatrix(vector<vector<int> > &codewords, Ref<BitMatrix> &matrix) {
+void LinesSampler::codewordsToBitMatrix(const vector<int> &codewords, const int symbolsPerLine,
+                                        Ref<BitMatrix> &matrix) {
   for (int i = 0; i < (int)codewords.size(); i++) {
-    for (int j = 0; j < (int)codewords[i].size(); j++) {
-      int moduleOffset = j * MODULES_IN_SYMBOL;
-      for (int k = 0; k < MODULES_IN_SYMBOL; k++) {
-        if ((codewords[i][j] & (1 << (MODULES_IN_SYMBOL - k - 1))) > 0) {
-          matrix->set(moduleOffset + k, i);
-        }
+    int codeword = codewords[i];
+    if (codeword == 0) {
+      continue;
+    }
+    int row = i / symbolsPerLine;
+    int moduleOffset = (i % symbolsPerLine) * MODULES_IN_SYMBOL;
+    for (int k = 0; k < MODULES_IN_SYMBOL; k++) {
+      if ((codeword & (1 << (MODULES_IN_SYMBOL - k - 1))) > 0) {
+        matrix->set(moduleOffset + k, row);
       }
     }
   }
@@ -228,14 +409,13 @@ void LinesSampler::computeSymbolWidths(vector<float> &symbolWidths, const int sy
   // Use the following property of PDF417 barcodes to detect symbols:
   // Every symbol starts with a black module and every symbol is 17 modules wide,
   // therefore there have to be columns in the line matrix that are completely composed of black pixels.
-  vector<int> blackCount(linesMatrix->getWidth(), 0);
+  const int height = linesMatrix->getHeight();
   for (int x = BARCODE_START_OFFSET; x < linesMatrix->getWidth(); x++) {
-    for (int y = 0; y < linesMatrix->getHeight(); y++) {
-      if (linesMatrix->get(x, y)) {
-        blackCount[x]++;
-      }
+    int y = 0;
+    while (y < height && linesMatrix->get(x, y)) {
+      y++;
     }
-    if (blackCount[x] == linesMatrix->getHeight()) {
+    if (y == height) {
       if (!lastWasSymbolStart) {
         float currentWidth = (float)(x - symbolStart);
         // Make sure we really found a symbol by asserting a minimal size of 75% of the expected symbol width.
@@ -282,12 +462,18 @@ void LinesSampler::computeSymbolWidths(vector<float> &symbolWidths, const int sy
 #endif
 }
 
-void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
+void LinesSampler::linesMatrixToCodewords(vector<int>& clusterNumbers,
                                           const int symbolsPerLine,
                                           const vector<float>& symbolWidths,
                                           Ref<BitMatrix> linesMatrix,
-                                          vector<vector<int> >& codewords)
+                                          vector<int>& codewords)
 {
+  const int width = linesMatrix->getWidth();
+  // One bar per pixel at most, plus the empty bar after the last one; reused for every line
+  vector<int> barWidths(width + 2, 0);
+  vector<int> cwStarts(symbolsPerLine, 0);
+  float cwRatios[BARS_IN_SYMBOL];
+
   for (int y = 0; y < linesMatrix->getHeight(); y++) {
     // Not sure if this is the right way to handle this but avoids an error:
     if (symbolsPerLine > (int)symbolWidths.size()) {
@@ -296,37 +482,31 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
 
     // TODO: use symbolWidths.size() instead of symbolsPerLine to at least decode some codewords
 
-    codewords[y].resize(symbolsPerLine, 0);
-    clusterNumbers[y].resize(symbolsPerLine, -1);
+    int *lineCodewords = &codewords[y * symbolsPerLine];
+    int *lineClusterNumbers = &clusterNumbers[y * symbolsPerLine];
     int line = y;
-    vector<int> barWidths(1, 0);
     int barCount = 0;
     // Runlength encode the bars in the scanned linesMatrix.
     // We assume that the first bar is black, as determined by the PDF417 standard.
     bool isSetBar = true;
     // Filter small white bars at the beginning of the barcode.
     // Small white bars may occur due to small deviations in scan line sampling.
-    barWidths[0] += BARCODE_START_OFFSET;
-    for (int x = BARCODE_START_OFFSET; x < linesMatrix->getWidth(); x++) {
-      if (linesMatrix->get(x, line)) {
-        if (!isSetBar) {
-          isSetBar = true;
-          barCount++;
-          barWidths.resize(barWidths.size() + 1);
-        }
-      } else {
-        if (isSetBar) {
-          isSetBar = false;
-          barCount++;
-          barWidths.resize(barWidths.size() + 1);
-        }
-
+    barWidths[0] = BARCODE_START_OFFSET;
+    int x = BARCODE_START_OFFSET;
+    while (true) {
+      int barEnd = isSetBar ? linesMatrix->getNextUnset(x, line) : linesMatrix->getNextSet(x, line);
+      barWidths[barCount] += barEnd - x;
+      x = barEnd;
+      if (x >= width) {
+        break;
       }
-      barWidths[barCount]++;
+      isSetBar = !isSetBar;
+      barCount++;
+      barWidths[barCount] = 0;
     }
     // Don't forget the last bar.
     barCount++;
-    barWidths.resize(barWidths.size() + 1);
+    barWidths[barCount] = 0;
 
 #if PDF417_DIAG && OUTPUT_BAR_WIDTH
     {
@@ -343,10 +523,10 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
     // We make sure, that the last bar of a symbol is always white, as determined by the PDF417 standard.
     // This helps to reduce the amount of errors done during the symbol recognition.
     // The symbolWidth usually is not constant over the width of the barcode.
+    // Starts past the last bar found stay 0, marking those symbols as unreadable
     int cwWidth = 0;
     int cwCount = 0;
-    vector<int> cwStarts(symbolsPerLine, 0);
-    cwStarts[0] = 0;
+    std::fill(cwStarts.begin(), cwStarts.end(), 0);
     cwCount++;
     for (int i = 0; i < barCount && cwCount < symbolsPerLine; i++) {
       cwWidth += barWidths[i];
@@ -371,10 +551,8 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
 
     ///////////////////////////////////////////
 
-    vector<vector<float> > cwRatios(symbolsPerLine);
     // Distribute bar widths to modules of a codeword.
     for (int i = 0; i < symbolsPerLine; i++) {
-      cwRatios[i].resize(BARS_IN_SYMBOL, 0.0f);
       const int cwStart = cwStarts[i];
       const int cwEnd = (i == symbolsPerLine - 1) ? barCount : cwStarts[i + 1];
       const int cwLength = cwEnd - cwStart;
@@ -395,37 +573,22 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
       // Assume the length of the symbol is symbolWidth and the last (unrecognized) bar uses all remaining space.
       if (cwLength == 7) {
         for (int j = 0; j < cwLength; ++j) {
-          cwRatios[i][j] = (float)barWidths[cwStart + j] / symbolWidths[i];
+          cwRatios[j] = (float)barWidths[cwStart + j] / symbolWidths[i];
         }
-        cwRatios[i][7] = (symbolWidths[i] - cwWidth) / symbolWidths[i];
+        cwRatios[7] = (symbolWidths[i] - cwWidth) / symbolWidths[i];
       } else {
-        for (int j = 0; j < (int)cwRatios[i].size(); ++j) {
-          cwRatios[i][j] = (float)barWidths[cwStart + j] / cwWidth;
+        for (int j = 0; j < BARS_IN_SYMBOL; ++j) {
+          cwRatios[j] = (float)barWidths[cwStart + j] / cwWidth;
         }
       }
 
-      float bestMatchError = std::numeric_limits<float>::max();
-      int bestMatch = 0;
-
       // Search for the most possible codeword by comparing the ratios of bar size to symbol width.
       // The sum of the squared differences is used as similarity metric.
       // (Picture it as the square euclidian distance in the space of eight tuples where a tuple represents the bar ratios.)
-      for (int j = 0; j < POSSIBLE_SYMBOLS; j++) {
-        float error = 0.0f;
-        for (int k = 0; k < BARS_IN_SYMBOL; k++) {
-          float diff = RATIOS_TABLE[j * BARS_IN_SYMBOL + k] - cwRatios[i][k];
-          error += diff * diff;
-          if (error >= bestMatchError) {
-            break;
-          }
-        }
-        if (error < bestMatchError) {
-          bestMatchError = error;
-          bestMatch = BitMatrixParser::SYMBOL_TABLE[j];
-        }
-      }
-      codewords[y][i] = bestMatch;
-      clusterNumbers[y][i] = calculateClusterNumber(bestMatch);
+      int symbolIndex = SYMBOL_INDEX.findClosest(cwRatios);
+      int bestMatch = symbolIndex < 0 ? 0 : BitMatrixParser::SYMBOL_TABLE[symbolIndex];
+      lineCodewords[i] = bestMatch;
+      lineClusterNumbers[i] = calculateClusterNumber(bestMatch);
     }
   }
 
@@ -433,10 +596,10 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
 #if PDF417_DIAG && OUTPUT_CLUSTER_NUMBERS
   {
     for (int i = 0; i < clusterNumbers.size(); i++) {
-      for (int j = 0; j < clusterNumbers[i].size(); j++) {
-        cout << clusterNumbers[i][j] << ", ";
+      cout << clusterNumbers[i] << ", ";
+      if ((i + 1) % symbolsPerLine == 0) {
+        cout << endl;
       }
-      cout << endl;
     }
   }
 #endif
@@ -444,8 +607,8 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
 
 #if PDF417_DIAG
   {
-    Ref<BitMatrix> bits(new BitMatrix(symbolsPerLine * MODULES_IN_SYMBOL, codewords.size()));
-    codewordsToBitMatrix(codewords, bits);
+    Ref<BitMatrix> bits(new BitMatrix(symbolsPerLine * MODULES_IN_SYMBOL, codewords.size() / symbolsPerLine));
+    codewordsToBitMatrix(codewords, symbolsPerLine, bits);
     static int __cnt__ = 0;
     stringstream ss;
     ss << "pdf417-detectedRaw" << __cnt__++ << ".png";
@@ -454,31 +617,36 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
 #endif
 }
 
-vector<vector<map<int,  int> > >
-LinesSampler::distributeVotes(const int symbolsPerLine,
-                              const vector<vector<int> >& codewords,
-                              const vector<vector<int> >& clusterNumbers)
+void LinesSampler::distributeVotes(const int symbolsPerLine,
+                                   const vector<int>& codewords,
+                                   const vector<int>& clusterNumbers,
+                                   vector<int>& detectedCodeWords)
 {
   // Matrix of votes for codewords which are possible at this position.
-  vector<vector<map<int, int> > > votes(1);
-  votes[0].resize(symbolsPerLine);
+  VoteGrid votes(symbolsPerLine);
+  votes.ensureRows(1);
 
   int currentRow = 0;
-  map<int, int> clusterNumberVotes;
+  int clusterNumberVotes[9];
   int lastLineClusterNumber = -1;
 
-  for (int y = 0; y < (int)codewords.size(); y++) {
+  for (int y = 0; y < (int)codewords.size() / symbolsPerLine; y++) {
+    const int *lineCodewords = &codewords[y * symbolsPerLine];
+    const int *lineClusterNumbers = &clusterNumbers[y * symbolsPerLine];
+
     // Vote for the most probable cluster number for this row.
-    clusterNumberVotes.clear();
-    for (int i = 0; i < (int)codewords[y].size(); i++) {
-      if (clusterNumbers[y][i] != -1) {
-        clusterNumberVotes[clusterNumbers[y][i]] = clusterNumberVotes[clusterNumbers[y][i]] + 1;
+    bool anyClusterNumber = false;
+    std::fill(clusterNumberVotes, clusterNumberVotes + 9, 0);
+    for (int i = 0; i < symbolsPerLine; i++) {
+      if (lineClusterNumbers[i] != -1) {
+        clusterNumberVotes[lineClusterNumbers[i]]++;
+        anyClusterNumber = true;
       }
     }
 
     // Ignore lines where no codeword could be read.
-    if (!clusterNumberVotes.empty()) {
-      VoteResult voteResult = getValueWithMaxVotes(clusterNumberVotes);
+    if (anyClusterNumber) {
+      VoteResult voteResult = getValueWithMaxVotes(clusterNumberVotes, 9);
       bool lineClusterNumberIsIndecisive = voteResult.isIndecisive();
       int lineClusterNumber = voteResult.getVote();
 
@@ -497,32 +665,23 @@ LinesSampler::distributeVotes(const int symbolsPerLine,
       if ((lineClusterNumber == 0 && lastLineClusterNumber == -1) || (lastLineClusterNumber != -1)) {
         if ((lineClusterNumber == ((lastLineClusterNumber + 3) % 9)) && (lastLineClusterNumber != -1)) {
           currentRow++;
-          if ((int)votes.size() < currentRow + 1) {
-            votes.resize(currentRow + 1);
-            votes[currentRow].resize(symbolsPerLine);
-          }
+          votes.ensureRows(currentRow + 1);
         }
 
         if ((lineClusterNumber == ((lastLineClusterNumber + 6) % 9)) && (lastLineClusterNumber != -1)) {
           currentRow += 2;
-          if ((int)votes.size() < currentRow + 1) {
-            votes.resize(currentRow + 1);
-            votes[currentRow].resize(symbolsPerLine);
-          }
+          votes.ensureRows(currentRow + 1);
         }
 
-        for (int i = 0; i < (int)codewords[y].size(); i++) {
-          if (clusterNumbers[y][i] != -1) {
-            if (clusterNumbers[y][i] == lineClusterNumber) {
-              votes[currentRow][i][codewords[y][i]] = votes[currentRow][i][codewords[y][i]] + 1;
-            } else if (clusterNumbers[y][i] == ((lineClusterNumber + 3) % 9)) {
-              if ((int)votes.size() < currentRow + 2) {
-                votes.resize(currentRow + 2);
-                votes[currentRow + 1].resize(symbolsPerLine);
-              }
-              votes[currentRow + 1][i][codewords[y][i]] = votes[currentRow + 1][i][codewords[y][i]] + 1;
-            } else if ((clusterNumbers[y][i] == ((lineClusterNumber + 6) % 9)) && (currentRow > 0)) {
-              votes[currentRow - 1][i][codewords[y][i]] = votes[currentRow - 1][i][codewords[y][i]] + 1;
+        for (int i = 0; i < symbolsPerLine; i++) {
+          if (lineClusterNumbers[i] != -1) {
+            if (lineClusterNumbers[i] == lineClusterNumber) {
+              votes.vote(currentRow, i, lineCodewords[i]);
+            } else if (lineClusterNumbers[i] == ((lineClusterNumber + 3) % 9)) {
+              votes.ensureRows(currentRow + 2);
+              votes.vote(currentRow + 1, i, lineCodewords[i]);
+            } else if ((lineClusterNumbers[i] == ((lineClusterNumber + 6) % 9)) && (currentRow > 0)) {
+              votes.vote(currentRow - 1, i, lineCodewords[i]);
             }
           }
         }
@@ -531,18 +690,24 @@ LinesSampler::distributeVotes(const int symbolsPerLine,
     }
   }
 
-  return votes;
+  detectedCodeWords.resize(votes.getRows() * symbolsPerLine);
+  for (int i = 0; i < votes.getRows(); i++) {
+    for (int j = 0; j < symbolsPerLine; j++) {
+      detectedCodeWords[i * symbolsPerLine + j] = votes.getWinner(i, j);
+    }
+  }
 }
 
 
 vector<int>
-LinesSampler::findMissingLines(const int symbolsPerLine, vector<vector<int> > &detectedCodeWords) {
+LinesSampler::findMissingLines(const int symbolsPerLine, vector<int> &detectedCodeWords) {
   vector<int> insertLinesAt;
-  if (detectedCodeWords.size() > 1) {
-    for (int i = 0; i < (int)detectedCodeWords.size() - 1; i++) {
+  const int rows = (int)detectedCodeWords.size() / symbolsPerLine;
+  if (rows > 1) {
+    for (int i = 0; i < rows - 1; i++) {
       int clusterNumberRow = -1;
-      for (int j = 0; j < (int)detectedCodeWords[i].size() && clusterNumberRow == -1; j++) {
-        int clusterNumber = calculateClusterNumber(detectedCodeWords[i][j]);
+      for (int j = 0; j < symbolsPerLine && clusterNumberRow == -1; j++) {
+        int clusterNumber = calculateClusterNumber(detectedCodeWords[i * symbolsPerLine + j]);
         if (clusterNumber != -1) {
           clusterNumberRow = clusterNumber;
         }
@@ -557,8 +722,8 @@ LinesSampler::findMissingLines(const int symbolsPerLine, vector<vector<int> > &d
         }
       }
       int clusterNumberNextRow = -1;
-      for (int j = 0; j < (int)detectedCodeWords[i + 1].size() && clusterNumberNextRow == -1; j++) {
-        int clusterNumber = calculateClusterNumber(detectedCodeWords[i + 1][j]);
+      for (int j = 0; j < symbolsPerLine && clusterNumberNextRow == -1; j++) {
+        int clusterNumber = calculateClusterNumber(detectedCodeWords[(i + 1) * symbolsPerLine + j]);
         if (clusterNumber != -1) {
           clusterNumberNextRow = clusterNumber;
         }
@@ -577,25 +742,30 @@ LinesSampler::findMissingLines(const int symbolsPerLine, vector<vector<int> > &d
   }
 
   for (int i = 0; i < (int)insertLinesAt.size(); i++) {
-    detectedCodeWords.insert(detectedCodeWords.begin() + insertLinesAt[i] + i, vector<int>(symbolsPerLine, 0));
+    detectedCodeWords.insert(detectedCodeWords.begin() + (insertLinesAt[i] + i) * symbolsPerLine, symbolsPerLine, 0);
   }
 
   return insertLinesAt;
 }
 
-int LinesSampler::decodeRowCount(const int symbolsPerLine, vector<vector<int> > &detectedCodeWords, vector<int> &insertLinesAt)
+int LinesSampler::decodeRowCount(const int symbolsPerLine, vector<int> &detectedCodeWords, vector<int> &insertLinesAt)
 {
   // Use the information in the first and last column to determin the number of rows and find more missing rows.
   // For missing rows insert blank space, so the error correction can try to fill them in.
 
-  map<int, int> rowCountVotes;
-  map<int, int> ecLevelVotes;
-  map<int, int> rowNumberVotes;
+  // Codewords are below 929: row numbers run to 30, row counts to 89 and EC levels to 9
+  int rowCountVotes[90] = {0};
+  int ecLevelVotes[10] = {0};
+  int rowNumberVotes[31];
   int lastRowNumber = -1;
   insertLinesAt.clear();
 
-  for (int i = 0; i + 2 < (int)detectedCodeWords.size(); i += 3) {
-    rowNumberVotes.clear();
+  const int rows = (int)detectedCodeWords.size() / symbolsPerLine;
+  for (int i = 0; i + 2 < rows; i += 3) {
+    std::fill(rowNumberVotes, rowNumberVotes + 31, 0);
+    const int *first = &detectedCodeWords[i * symbolsPerLine];
+    const int *second = first + symbolsPerLine;
+    const int *third = second + symbolsPerLine;
     int firstCodewordDecodedLeft = -1;
     int secondCodewordDecodedLeft = -1;
     int thirdCodewordDecodedLeft = -1;
@@ -603,67 +773,61 @@ int LinesSampler::decodeRowCount(const int symbolsPerLine, vector<vector<int> >
     int secondCodewordDecodedRight = -1;
     int thirdCodewordDecodedRight = -1;
 
-    if (detectedCodeWords[i][0] != 0) {
-      firstCodewordDecodedLeft = BitMatrixParser::getCodeword(detectedCodeWords[i][0]);
+    if (first[0] != 0) {
+      firstCodewordDecodedLeft = BitMatrixParser::getCodeword(first[0]);
     }
-    if (detectedCodeWords[i + 1][0] != 0) {
-      secondCodewordDecodedLeft = BitMatrixParser::getCodeword(detectedCodeWords[i + 1][0]);
+    if (second[0] != 0) {
+      secondCodewordDecodedLeft = BitMatrixParser::getCodeword(second[0]);
     }
-    if (detectedCodeWords[i + 2][0] != 0) {
-      thirdCodewordDecodedLeft = BitMatrixParser::getCodeword(detectedCodeWords[i + 2][0]);
+    if (third[0] != 0) {
+      thirdCodewordDecodedLeft = BitMatrixParser::getCodeword(third[0]);
     }
 
-    if (detectedCodeWords[i][detectedCodeWords[i].size() - 1] != 0) {
-      firstCodewordDecodedRight = BitMatrixParser::getCodeword(detectedCodeWords[i][detectedCodeWords[i].size() - 1]);
+    if (first[symbolsPerLine - 1] != 0) {
+      firstCodewordDecodedRight = BitMatrixParser::getCodeword(first[symbolsPerLine - 1]);
     }
-    if (detectedCodeWords[i + 1][detectedCodeWords[i + 1].size() - 1] != 0) {
-      secondCodewordDecodedRight = BitMatrixParser::getCodeword(detectedCodeWords[i + 1][detectedCodeWords[i + 1].size() - 1]);
+    if (second[symbolsPerLine - 1] != 0) {
+      secondCodewordDecodedRight = BitMatrixParser::getCodeword(second[symbolsPerLine - 1]);
     }
-    if (detectedCodeWords[i + 2][detectedCodeWords[i + 2].size() - 1] != 0) {
-      thirdCodewordDecodedRight = BitMatrixParser::getCodeword(detectedCodeWords[i + 2][detectedCodeWords[i + 2].size() - 1]);
+    if (third[symbolsPerLine - 1] != 0) {
+      thirdCodewordDecodedRight = BitMatrixParser::getCodeword(third[symbolsPerLine - 1]);
     }
 
     if (firstCodewordDecodedLeft != -1 && secondCodewordDecodedLeft != -1) {
       int leftRowCount = ((firstCodewordDecodedLeft % 30) * 3) + ((secondCodewordDecodedLeft % 30) % 3);
       int leftECLevel = (secondCodewordDecodedLeft % 30) / 3;
 
-      rowCountVotes[leftRowCount] = rowCountVotes[leftRowCount] + 1;
-      ecLevelVotes[leftECLevel] = ecLevelVotes[leftECLevel] + 1;
+      rowCountVotes[leftRowCount]++;
+      ecLevelVotes[leftECLevel]++;
     }
 
     if (secondCodewordDecodedRight != -1 && thirdCodewordDecodedRight != -1) {
       int rightRowCount = ((secondCodewordDecodedRight % 30) * 3) + ((thirdCodewordDecodedRight % 30) % 3);
       int rightECLevel = (thirdCodewordDecodedRight % 30) / 3;
 
-      rowCountVotes[rightRowCount] = rowCountVotes[rightRowCount] + 1;
-      ecLevelVotes[rightECLevel] = ecLevelVotes[rightECLevel] + 1;
+      rowCountVotes[rightRowCount]++;
+      ecLevelVotes[rightECLevel]++;
     }
 
     if (firstCodewordDecodedLeft != -1) {
-      int rowNumber = firstCodewordDecodedLeft / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[firstCodewordDecodedLeft / 30]++;
     }
     if (secondCodewordDecodedLeft != -1) {
-      int rowNumber = secondCodewordDecodedLeft / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[secondCodewordDecodedLeft / 30]++;
     }
     if (thirdCodewordDecodedLeft != -1) {
-      int rowNumber = thirdCodewordDecodedLeft / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[thirdCodewordDecodedLeft / 30]++;
     }
     if (firstCodewordDecodedRight != -1) {
-      int rowNumber = firstCodewordDecodedRight / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[firstCodewordDecodedRight / 30]++;
     }
     if (secondCodewordDecodedRight != -1) {
-      int rowNumber = secondCodewordDecodedRight / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[secondCodewordDecodedRight / 30]++;
     }
     if (thirdCodewordDecodedRight != -1) {
-      int rowNumber = thirdCodewordDecodedRight / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[thirdCodewordDecodedRight / 30]++;
     }
-    int rowNumber = getValueWithMaxVotes(rowNumberVotes).getVote();
+    int rowNumber = getValueWithMaxVotes(rowNumberVotes, 31).getVote();
     if (lastRowNumber + 1 < rowNumber) {
       for (int j = lastRowNumber + 1; j < rowNumber; j++) {
         insertLinesAt.push_back(i);
@@ -675,11 +839,11 @@ int LinesSampler::decodeRowCount(const int symbolsPerLine, vector<vector<int> >
   }
 
   for (int i = 0; i < (int)insertLinesAt.size(); i++) {
-    detectedCodeWords.insert(detectedCodeWords.begin() + insertLinesAt[i] + i, vector<int>(symbolsPerLine, 0));
+    detectedCodeWords.insert(detectedCodeWords.begin() + (insertLinesAt[i] + i) * symbolsPerLine, symbolsPerLine, 0);
   }
 
-  int rowCount = getValueWithMaxVotes(rowCountVotes).getVote();
-  // int ecLevel = getValueWithMaxVotes(ecLevelVotes);
+  int rowCount = getValueWithMaxVotes(rowCountVotes, 90).getVote();
+  // int ecLevel = getValueWithMaxVotes(ecLevelVotes, 10).getVote();
 
 #if PDF417_DIAG && OUTPUT_EC_LEVEL
   {
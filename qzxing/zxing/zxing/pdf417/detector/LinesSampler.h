@@ -17,7 +17,7 @@
  * limitations under the License.
  */
 
-#include <map>
+#include <vector>
 #include <zxing/common/BitMatrix.h>
 #include <zxing/ResultPoint.h>
 #include <zxing/common/Point.h>
@@ -31,10 +31,15 @@ private:
   static const int MODULES_IN_SYMBOL = 17;
   static const int BARS_IN_SYMBOL = 8;
   static const int POSSIBLE_SYMBOLS = 2787;
-  static const std::vector<float> RATIOS_TABLE;
-  static std::vector<float> init_ratios_table();
   static const int BARCODE_START_OFFSET = 2;
 
+  /**
+   * The bar widths of every symbol, grouped by the widths of their first two
+   * bars so that the search for the closest symbol can skip whole groups.
+   */
+  struct SymbolIndex;
+  static const SymbolIndex SYMBOL_INDEX;
+
   Ref<BitMatrix> linesMatrix_;
   int symbolsPerLine_;
   int dimension_;
@@ -84,27 +89,28 @@ private:
                               int dimensionY,
                               int dimension);
 
-  static void codewordsToBitMatrix(std::vector<std::vector<int> > &codewords,
+  static void codewordsToBitMatrix(const std::vector<int> &codewords,
+                                   const int symbolsPerLine,
                                    Ref<BitMatrix> &matrix);
   static int calculateClusterNumber(int codeword);
   static Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image,
                                    int dimension);
   static void computeSymbolWidths(std::vector<float>& symbolWidths,
                                   const int symbolsPerLine, Ref<BitMatrix> linesMatrix);
-  static void linesMatrixToCodewords(std::vector<std::vector<int> > &clusterNumbers,
+  static void linesMatrixToCodewords(std::vector<int> &clusterNumbers,
                                      const int symbolsPerLine,
                                      const std::vector<float> &symbolWidths,
                                      Ref<BitMatrix> linesMatrix,
-                                     std::vector<std::vector<int> > &codewords);
-  static std::vector<std::vector<std::map<int, int> > >
-      distributeVotes(const int symbolsPerLine,
-                      const std::vector<std::vector<int> >& codewords,
-                      const std::vector<std::vector<int> >& clusterNumbers);
+                                     std::vector<int> &codewords);
+  static void distributeVotes(const int symbolsPerLine,
+                              const std::vector<int> &codewords,
+                              const std::vector<int> &clusterNumbers,
+                              std::vector<int> &detectedCodeWords);
   static std::vector<int>
       findMissingLines(const int symbolsPerLine,
-                       std::vector<std::vector<int> > &detectedCodeWords);
+                       std::vector<int> &detectedCodeWords);
   static int decodeRowCount(const int symbolsPerLine,
-                            std::vector<std::vector<int> > &detectedCodeWords,
+                            std::vector<int> &detectedCodeWords,
                             std::vector<int> &insertLinesAt);
 
   static int round(float d);
@@ -42,6 +42,13 @@ using zxing::BinaryBitmap;
 using zxing::DecodeHints;
 using zxing::Line;
 
+namespace {
+
+// Length of the longest guard pattern, the stop pattern
+const int MAX_PATTERN_LENGTH = 9;
+
+}
+
 /**
  * <p>Encapsulates logic that can detect a PDF417 Code in an image, even if the
  * PDF417 Code is rotated or skewed, or partially obscured.</p>
@@ -151,62 +158,47 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices(Ref<BitMatrix> matrix, int r
   ArrayRef< Ref<ResultPoint> > result(16);
   bool found = false;
 
-  ArrayRef<int> counters(new Array<int>(START_PATTERN_LENGTH));
+  int loc[2];
 
   // Top Left
-  for (int i = 0; i < height; i += rowStep) {
-    ArrayRef<int> loc = findGuardPattern(matrix, 0, i, width, false, START_PATTERN,
-                                         START_PATTERN_LENGTH, counters);
-    if (loc) {
-      result[0] = new ResultPoint((float)loc[0], (float)i);
-      result[4] = new ResultPoint((float)loc[1], (float)i);
-      found = true;
-      break;
-    }
+  int row = findGuardRow(matrix, 0, rowStep, 0, width, false, START_PATTERN,
+                         START_PATTERN_LENGTH, loc);
+  if (row >= 0) {
+    result[0] = new ResultPoint((float)loc[0], (float)row);
+    result[4] = new ResultPoint((float)loc[1], (float)row);
+    found = true;
   }
   // Bottom left
   if (found) { // Found the Top Left vertex
     found = false;
-    for (int i = height - 1; i > 0; i -= rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, width, false, START_PATTERN,
-                                           START_PATTERN_LENGTH, counters);
-      if (loc) {
-        result[1] = new ResultPoint((float)loc[0], (float)i);
-        result[5] = new ResultPoint((float)loc[1], (float)i);
-        found = true;
-        break;
-      }
+    row = findGuardRow(matrix, height - 1, -rowStep, 0, width, false, START_PATTERN,
+                       START_PATTERN_LENGTH, loc);
+    if (row >= 0) {
+      result[1] = new ResultPoint((float)loc[0], (float)row);
+      result[5] = new ResultPoint((float)loc[1], (float)row);
+      found = true;
     }
   }
-
-  counters = new Array<int>(STOP_PATTERN_LENGTH);
-
   // Top right
   if (found) { // Found the Bottom Left vertex
     found = false;
-    for (int i = 0; i < height; i += rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, width, false, STOP_PATTERN,
-                                           STOP_PATTERN_LENGTH, counters);
-      if (loc) {
-        result[2] = new ResultPoint((float)loc[1], (float)i);
-        result[6] = new ResultPoint((float)loc[0], (float)i);
-        found = true;
-        break;
-      }
+    row = findGuardRow(matrix, 0, rowStep, 0, width, false, STOP_PATTERN,
+                       STOP_PATTERN_LENGTH, loc);
+    if (row >= 0) {
+      result[2] = new ResultPoint((float)loc[1], (float)row);
+      result[6] = new ResultPoint((float)loc[0], (float)row);
+      found = true;
     }
   }
   // Bottom right
   if (found) { // Found the Top right vertex
     found = false;
-    for (int i = height - 1; i > 0; i -= rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, width, false, STOP_PATTERN,
-                                           STOP_PATTERN_LENGTH, counters);
-      if (loc) {
-        result[3] = new ResultPoint((float)loc[1], (float)i);
-        result[7] = new ResultPoint((float)loc[0], (float)i);
-        found = true;
-        break;
-      }
+    row = findGuardRow(matrix, height - 1, -rowStep, 0, width, false, STOP_PATTERN,
+                       STOP_PATTERN_LENGTH, loc);
+    if (row >= 0) {
+      result[3] = new ResultPoint((float)loc[1], (float)row);
+      result[7] = new ResultPoint((float)loc[0], (float)row);
+      found = true;
     }
   }
 
@@ -221,70 +213,80 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices180(Ref<BitMatrix> matrix, in
   ArrayRef< Ref<ResultPoint> > result(16);
   bool found = false;
   
-  ArrayRef<int> counters = new Array<int>(START_PATTERN_REVERSE_LENGTH);
+  int loc[2];
   
   // Top Left
-  for (int i = height - 1; i > 0; i -= rowStep) {
-    ArrayRef<int> loc =
-        findGuardPattern(matrix, halfWidth, i, halfWidth, true, START_PATTERN_REVERSE,
-                         START_PATTERN_REVERSE_LENGTH, counters);
-    if (loc) {
-      result[0] = new ResultPoint((float)loc[1], (float)i);
-      result[4] = new ResultPoint((float)loc[0], (float)i);
-      found = true;
-      break;
-    }
+  int row = findGuardRow(matrix, height - 1, -rowStep, halfWidth, halfWidth, true,
+                         START_PATTERN_REVERSE, START_PATTERN_REVERSE_LENGTH, loc);
+  if (row >= 0) {
+    result[0] = new ResultPoint((float)loc[1], (float)row);
+    result[4] = new ResultPoint((float)loc[0], (float)row);
+    found = true;
   }
   // Bottom Left
   if (found) { // Found the Top Left vertex
     found = false;
-    for (int i = 0; i < height; i += rowStep) {
-      ArrayRef<int> loc =
-          findGuardPattern(matrix, halfWidth, i, halfWidth, true, START_PATTERN_REVERSE,
-                           START_PATTERN_REVERSE_LENGTH, counters);
-      if (loc) {
-        result[1] = new ResultPoint((float)loc[1], (float)i);
-        result[5] = new ResultPoint((float)loc[0], (float)i);
-        found = true;
-        break;
-      }
+    row = findGuardRow(matrix, 0, rowStep, halfWidth, halfWidth, true,
+                       START_PATTERN_REVERSE, START_PATTERN_REVERSE_LENGTH, loc);
+    if (row >= 0) {
+      result[1] = new ResultPoint((float)loc[1], (float)row);
+      result[5] = new ResultPoint((float)loc[0], (float)row);
+      found = true;
     }
   }
-
-  counters = new Array<int>(STOP_PATTERN_REVERSE_LENGTH);
-
   // Top Right
   if (found) { // Found the Bottom Left vertex
     found = false;
-    for (int i = height - 1; i > 0; i -= rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, halfWidth, false, STOP_PATTERN_REVERSE,
-                                           STOP_PATTERN_REVERSE_LENGTH, counters);
-      if (loc) {
-        result[2] = new ResultPoint((float)loc[0], (float)i);
-        result[6] = new ResultPoint((float)loc[1], (float)i);
-        found = true;
-        break;
-      }
+    row = findGuardRow(matrix, height - 1, -rowStep, 0, halfWidth, false,
+                       STOP_PATTERN_REVERSE, STOP_PATTERN_REVERSE_LENGTH, loc);
+    if (row >= 0) {
+      result[2] = new ResultPoint((float)loc[0], (float)row);
+      result[6] = new ResultPoint((float)loc[1], (float)row);
+      found = true;
     }
   }
   // Bottom Right
   if (found) { // Found the Top Right vertex
     found = false;
-    for (int i = 0; i < height; i += rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, halfWidth, false, STOP_PATTERN_REVERSE,
-                                           STOP_PATTERN_REVERSE_LENGTH, counters);
-      if (loc) {
-        result[3] = new ResultPoint((float)loc[0], (float)i);
-        result[7] = new ResultPoint((float)loc[1], (float)i);
-        found = true;
-        break;
-      }
+    row = findGuardRow(matrix, 0, rowStep, 0, halfWidth, false,
+                       STOP_PATTERN_REVERSE, STOP_PATTERN_REVERSE_LENGTH, loc);
+    if (row >= 0) {
+      result[3] = new ResultPoint((float)loc[0], (float)row);
+      result[7] = new ResultPoint((float)loc[1], (float)row);
+      found = true;
     }
   }
 
   return found ? result : ArrayRef< Ref<ResultPoint> >();
 }
 
+/**
+ * Scans the rows firstRow, firstRow + rowStep, ... that lie inside the matrix
+ * for a guard pattern.
+ *
+ * @param rowStep distance between the scanned rows, negative to go upwards.
+ * @param loc receives the start and end column of the pattern found.
+ * @return the first row in scan order holding the pattern, -1 if none does.
+ */
+int Detector::findGuardRow(Ref<BitMatrix> const& matrix,
+                           int firstRow,
+                           int rowStep,
+                           int column,
+                           int width,
+                           bool whiteFirst,
+                           const int pattern[],
+                           int patternSize,
+                           int loc[2]) {
+  const int height = matrix->getHeight();
+  // The upward scans never look at row 0
+  for (int row = firstRow; rowStep > 0 ? row < height : row > 0; row += rowStep) {
+    if (findGuardPattern(matrix, column, row, width, whiteFirst, pattern, patternSize, loc)) {
+      return row;
+    }
+  }
+  return -1;
+}
+
 /**
  * @param matrix row of black/white values to search
  * @param column x position to start search
@@ -292,35 +294,39 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices180(Ref<BitMatrix> matrix, in
  * @param width the number of pixels to search on this row
  * @param pattern pattern of counts of number of black and white pixels that are
  *                 being searched for as a pattern
- * @param counters array of counters, as long as pattern, to re-use
- * @return start/end horizontal offset of guard pattern, as an array of two ints.
+ * @param loc receives the start/end horizontal offset of the guard pattern
+ * @return true if the guard pattern was found.
  */
-ArrayRef<int> Detector::findGuardPattern(Ref<BitMatrix> matrix,
-                                         int column,
-                                         int row,
-                                         int width,
-                                         bool whiteFirst,
-                                         const int pattern[],
-                                         int patternSize,
-                                         ArrayRef<int>& counters) {
-  counters->values().assign(counters->size(), 0);
+bool Detector::findGuardPattern(Ref<BitMatrix> const& matrix,
+                                int column,
+                                int row,
+                                int width,
+                                bool whiteFirst,
+                                const int pattern[],
+                                int patternSize,
+                                int loc[2]) {
+  int counters[MAX_PATTERN_LENGTH] = {0};
   int patternLength = patternSize;
   bool isWhite = whiteFirst;
 
   int counterPosition = 0;
   int patternStart = column;
-  for (int x = column; x < column + width; x++) {
+  const int end = column + width;
+  // Walk the row one run of equal pixels at a time. Counters only move on
+  // colour changes, so this counts exactly like a pixel by pixel scan.
+  int x = column;
+  while (x < end) {
     bool pixel = matrix->get(x, row);
+    int runEnd = std::min(pixel ? matrix->getNextUnset(x, row) : matrix->getNextSet(x, row), end);
     if (pixel ^ isWhite) {
-      counters[counterPosition]++;
+      counters[counterPosition] += runEnd - x;
     } else {
       if (counterPosition == patternLength - 1) {
-        if (patternMatchVariance(counters, pattern,
+        if (patternMatchVariance(counters, pattern, patternLength,
                                  MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
-          ArrayRef<int> result = new Array<int>(2);
-          result[0] = patternStart;
-          result[1] = x;
-          return result;
+          loc[0] = patternStart;
+          loc[1] = x;
+          return true;
         }
         patternStart += counters[0] + counters[1];
         for(int i = 0; i < patternLength - 2; ++i)
@@ -331,11 +337,12 @@ ArrayRef<int> Detector::findGuardPattern(Ref<BitMatrix> matrix,
       } else {
         counterPosition++;
       }
-      counters[counterPosition] = 1;
+      counters[counterPosition] = runEnd - x;
       isWhite = !isWhite;
     }
+    x = runEnd;
   }
-  return ArrayRef<int>();
+  return false;
 }
 
 /**
@@ -346,6 +353,7 @@ ArrayRef<int> Detector::findGuardPattern(Ref<BitMatrix> matrix,
  *
  * @param counters observed counters
  * @param pattern expected pattern
+ * @param patternSize number of counters and pattern elements
  * @param maxIndividualVariance The most any counter can differ before we give up
  * @return ratio of total variance between counters and pattern compared to
  *         total pattern size, where the ratio has been multiplied by 256.
@@ -353,11 +361,12 @@ ArrayRef<int> Detector::findGuardPattern(Ref<BitMatrix> matrix,
  *         variance between counters and patterns equals the pattern length,
  *         higher values mean even more variance
  */
-int Detector::patternMatchVariance(ArrayRef<int>& counters,
+int Detector::patternMatchVariance(const int counters[],
                                    const int pattern[],
+                                   int patternSize,
                                    int maxIndividualVariance)
 {
-  int numCounters = counters->size();
+  int numCounters = patternSize;
   int total = 0;
   int patternLength = 0;
   for (int i = 0; i < numCounters; i++) {
@@ -29,18 +29,70 @@ namespace zxing {
 		
 		using namespace std;
 		
-		QRCodeReader::QRCodeReader() :decoder_() {
+		QRCodeReader::QRCodeReader() :decoder_(), tracking_(false) {
 		}
         //TODO : see if any of the other files in the qrcode tree need tryHarder
 		Ref<Result> QRCodeReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
 			Detector detector(image->getBlackMatrix());
-			Ref<DetectorResult> detectorResult(detector.detect(hints));
+			Ref<DetectorResult> detectorResult;
+			Ref<DecoderResult> decoderResult;
+			if (isTracking()) {
+				try {
+					detectorResult = detector.track(trackedPoints_, hints);
+					decoderResult = decodeBits(detectorResult->getBits(), hints);
+				} catch (Exception const&) {
+					// Lost it, the next call searches the whole image
+					trackedPoints_ = ArrayRef< Ref<ResultPoint> >();
+					throw;
+				}
+			} else {
+				detectorResult = detector.detect(hints);
+				decoderResult = decodeBits(detectorResult->getBits(), hints);
+			}
 			ArrayRef< Ref<ResultPoint> > points (detectorResult->getPoints());
-			Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult->getBits()));
+			if (tracking_) {
+				trackedPoints_ = points;
+			}
 			Ref<Result> result(
                                new Result(decoderResult->getText(), decoderResult->getRawBytes(), points, BarcodeFormat::QR_CODE, decoderResult->charSet()));
 			return result;
 		}
+
+		Ref<DecoderResult> QRCodeReader::decodeBits(Ref<BitMatrix> bits, DecodeHints const& hints) {
+			Ref<DecoderResultCache> cache(hints.getDecoderResultCache());
+			if (!cache) {
+				return decoder_.decode(bits);
+			}
+			Ref<DecoderResult> decoderResult(cache->get(BarcodeFormat::QR_CODE, bits));
+			if (!decoderResult) {
+				// Decoding unmasks the bits in place, keep them as sampled
+				Ref<BitMatrix> sampled(bits->clone());
+				decoderResult = decoder_.decode(bits);
+				cache->put(BarcodeFormat::QR_CODE, sampled, decoderResult);
+			}
+			return decoderResult;
+		}
+
+		void QRCodeReader::setTracking(bool enabled) {
+			tracking_ = enabled;
+			if (!enabled) {
+				trackedPoints_ = ArrayRef< Ref<ResultPoint> >();
+			}
+		}
+
+		bool QRCodeReader::getTracking() const {
+			return tracking_;
+		}
+
+		bool QRCodeReader::isTracking() const {
+			return tracking_ && trackedPoints_ && trackedPoints_->size() >= 3;
+		}
+
+		void QRCodeReader::track(ArrayRef< Ref<ResultPoint> > points) {
+			if (tracking_) {
+				trackedPoints_ = points;
+			}
+		}
 		
 		QRCodeReader::~QRCodeReader() {
 		}
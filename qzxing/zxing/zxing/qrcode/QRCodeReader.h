@@ -31,15 +31,35 @@ namespace qrcode {
 class QRCodeReader : public Reader {
  private:
   Decoder decoder_;
-			
+  bool tracking_;
+  ArrayRef< Ref<ResultPoint> > trackedPoints_;
+
  protected:
   Decoder& getDecoder();
 
+  /** Decodes a sampled grid, going through the hints' result cache if any */
+  Ref<DecoderResult> decodeBits(Ref<BitMatrix> bits, DecodeHints const& hints);
+
  public:
   QRCodeReader();
   virtual ~QRCodeReader();
 			
   Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+
+  /**
+   * In tracking mode decode() remembers where it found the finder patterns
+   * and on the next call looks for them only around those spots, so a code
+   * that stays in view of a camera is found at little more than the cost of
+   * sampling it. When the code is not found there decode() throws and
+   * forgets the spots, the next call searches the whole image again. This
+   * leaves the full search to the caller, which may already run one.
+   */
+  void setTracking(bool enabled);
+  bool getTracking() const;
+  bool isTracking() const;
+
+  /** Starts tracking from the result points of a QR code decoded elsewhere */
+  void track(ArrayRef< Ref<ResultPoint> > points);
 };
 
 }
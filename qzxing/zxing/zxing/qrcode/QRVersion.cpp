@@ -22,86 +22,321 @@
 #include <zxing/qrcode/FormatInformation.h>
 #include <zxing/FormatException.h>
 #include <limits>
-#include <iostream>
-#include <cstdarg>
 
-using std::vector;
 using std::numeric_limits;
 
 namespace zxing {
 namespace qrcode {
 
-ECB::ECB(int count, int dataCodewords) :
-    count_(count), dataCodewords_(dataCodewords) {
-}
-
-int ECB::getCount() {
+int ECB::getCount() const {
   return count_;
 }
 
-int ECB::getDataCodewords() {
+int ECB::getDataCodewords() const {
   return dataCodewords_;
 }
 
-ECBlocks::ECBlocks(int ecCodewordsPerBloc, ECB *ecBlocks) :
-    ecCodewordsPerBloc_(ecCodewordsPerBloc), ecBlocks_(1, ecBlocks) {
-}
-
-ECBlocks::ECBlocks(int ecCodewordsPerBloc, ECB *ecBlocks1, ECB *ecBlocks2) :
-    ecCodewordsPerBloc_(ecCodewordsPerBloc), ecBlocks_(1, ecBlocks1) {
-  ecBlocks_.push_back(ecBlocks2);
-}
-
-int ECBlocks::getECCodewordsPerBloc()
+int ECBlocks::getECCodewordsPerBloc() const
 {
   return ecCodewordsPerBloc_;
 }
 
-int ECBlocks::getTotalECCodewords()
+int ECBlocks::getTotalECCodewords() const
 {
-    return ecBlocks_.size();
+    return numECBlocks_;
 }
 
-std::vector<ECB*>& ECBlocks::getECBlocks() {
-  return ecBlocks_;
+int ECBlocks::getNumECBlocks() const {
+  return numECBlocks_;
 }
 
-ECBlocks::~ECBlocks() {
-  for (size_t i = 0; i < ecBlocks_.size(); i++) {
-    delete ecBlocks_[i];
-  }
+const ECB &ECBlocks::getECBlock(int i) const {
+  return ecBlocks_[i];
 }
 
-unsigned int Version::VERSION_DECODE_INFO[] = { 0x07C94, 0x085BC, 0x09A99, 0x0A4D3, 0x0BBF6, 0x0C762, 0x0D847, 0x0E60D,
+const unsigned int Version::VERSION_DECODE_INFO[] = { 0x07C94, 0x085BC, 0x09A99, 0x0A4D3, 0x0BBF6, 0x0C762, 0x0D847, 0x0E60D,
     0x0F928, 0x10B78, 0x1145D, 0x12A17, 0x13532, 0x149A6, 0x15683, 0x168C9, 0x177EC, 0x18EC4, 0x191E1, 0x1AFAB,
     0x1B08E, 0x1CC1A, 0x1D33F, 0x1ED75, 0x1F250, 0x209D5, 0x216F0, 0x228BA, 0x2379F, 0x24B0B, 0x2542E, 0x26A64,
     0x27541, 0x28C69
                                               };
-int Version::N_VERSION_DECODE_INFOS = 34;
-vector<Ref<Version> > Version::VERSIONS;
-static int N_VERSIONS = Version::buildVersions();
+const int Version::N_VERSION_DECODE_INFOS = 34;
+
+/**
+ * Alignment pattern centers of each version, count first, as in Annex E of
+ * ISO 18004:2006.
+ */
+static const int ALIGNMENT_PATTERN_CENTERS[][8] = {
+  {0},
+  {2, 6, 18},
+  {2, 6, 22},
+  {2, 6, 26},
+  {2, 6, 30},
+  {2, 6, 34},
+  {3, 6, 22, 38},
+  {3, 6, 24, 42},
+  {3, 6, 26, 46},
+  {3, 6, 28, 50},
+  {3, 6, 30, 54},
+  {3, 6, 32, 58},
+  {3, 6, 34, 62},
+  {4, 6, 26, 46, 66},
+  {4, 6, 26, 48, 70},
+  {4, 6, 26, 50, 74},
+  {4, 6, 30, 54, 78},
+  {4, 6, 30, 56, 82},
+  {4, 6, 30, 58, 86},
+  {4, 6, 34, 62, 90},
+  {5, 6, 28, 50, 72, 94},
+  {5, 6, 26, 50, 74, 98},
+  {5, 6, 30, 54, 78, 102},
+  {5, 6, 28, 54, 80, 106},
+  {5, 6, 32, 58, 84, 110},
+  {5, 6, 30, 58, 86, 114},
+  {5, 6, 34, 62, 90, 118},
+  {6, 6, 26, 50, 74, 98, 122},
+  {6, 6, 30, 54, 78, 102, 126},
+  {6, 6, 26, 52, 78, 104, 130},
+  {6, 6, 30, 56, 82, 108, 134},
+  {6, 6, 34, 60, 86, 112, 138},
+  {6, 6, 30, 58, 86, 114, 142},
+  {6, 6, 34, 62, 90, 118, 146},
+  {7, 6, 30, 54, 78, 102, 126, 150},
+  {7, 6, 24, 50, 76, 102, 128, 154},
+  {7, 6, 28, 54, 80, 106, 132, 158},
+  {7, 6, 32, 58, 84, 110, 136, 162},
+  {7, 6, 26, 54, 82, 110, 138, 166},
+  {7, 6, 30, 58, 86, 114, 142, 170}
+};
+
+const Version Version::VERSIONS[] = {
+  Version(1, ALIGNMENT_PATTERN_CENTERS[0],
+          ECBlocks(7, ECB(1, 19)),
+          ECBlocks(10, ECB(1, 16)),
+          ECBlocks(13, ECB(1, 13)),
+          ECBlocks(17, ECB(1, 9))),
+  Version(2, ALIGNMENT_PATTERN_CENTERS[1],
+          ECBlocks(10, ECB(1, 34)),
+          ECBlocks(16, ECB(1, 28)),
+          ECBlocks(22, ECB(1, 22)),
+          ECBlocks(28, ECB(1, 16))),
+  Version(3, ALIGNMENT_PATTERN_CENTERS[2],
+          ECBlocks(15, ECB(1, 55)),
+          ECBlocks(26, ECB(1, 44)),
+          ECBlocks(18, ECB(2, 17)),
+          ECBlocks(22, ECB(2, 13))),
+  Version(4, ALIGNMENT_PATTERN_CENTERS[3],
+          ECBlocks(20, ECB(1, 80)),
+          ECBlocks(18, ECB(2, 32)),
+          ECBlocks(26, ECB(2, 24)),
+          ECBlocks(16, ECB(4, 9))),
+  Version(5, ALIGNMENT_PATTERN_CENTERS[4],
+          ECBlocks(26, ECB(1, 108)),
+          ECBlocks(24, ECB(2, 43)),
+          ECBlocks(18, ECB(2, 15), ECB(2, 16)),
+          ECBlocks(22, ECB(2, 11), ECB(2, 12))),
+  Version(6, ALIGNMENT_PATTERN_CENTERS[5],
+          ECBlocks(18, ECB(2, 68)),
+          ECBlocks(16, ECB(4, 27)),
+          ECBlocks(24, ECB(4, 19)),
+          ECBlocks(28, ECB(4, 15))),
+  Version(7, ALIGNMENT_PATTERN_CENTERS[6],
+          ECBlocks(20, ECB(2, 78)),
+          ECBlocks(18, ECB(4, 31)),
+          ECBlocks(18, ECB(2, 14), ECB(4, 15)),
+          ECBlocks(26, ECB(4, 13), ECB(1, 14))),
+  Version(8, ALIGNMENT_PATTERN_CENTERS[7],
+          ECBlocks(24, ECB(2, 97)),
+          ECBlocks(22, ECB(2, 38), ECB(2, 39)),
+          ECBlocks(22, ECB(4, 18), ECB(2, 19)),
+          ECBlocks(26, ECB(4, 14), ECB(2, 15))),
+  Version(9, ALIGNMENT_PATTERN_CENTERS[8],
+          ECBlocks(30, ECB(2, 116)),
+          ECBlocks(22, ECB(3, 36), ECB(2, 37)),
+          ECBlocks(20, ECB(4, 16), ECB(4, 17)),
+          ECBlocks(24, ECB(4, 12), ECB(4, 13))),
+  Version(10, ALIGNMENT_PATTERN_CENTERS[9],
+          ECBlocks(18, ECB(2, 68), ECB(2, 69)),
+          ECBlocks(26, ECB(4, 43), ECB(1, 44)),
+          ECBlocks(24, ECB(6, 19), ECB(2, 20)),
+          ECBlocks(28, ECB(6, 15), ECB(2, 16))),
+  Version(11, ALIGNMENT_PATTERN_CENTERS[10],
+          ECBlocks(20, ECB(4, 81)),
+          ECBlocks(30, ECB(1, 50), ECB(4, 51)),
+          ECBlocks(28, ECB(4, 22), ECB(4, 23)),
+          ECBlocks(24, ECB(3, 12), ECB(8, 13))),
+  Version(12, ALIGNMENT_PATTERN_CENTERS[11],
+          ECBlocks(24, ECB(2, 92), ECB(2, 93)),
+          ECBlocks(22, ECB(6, 36), ECB(2, 37)),
+          ECBlocks(26, ECB(4, 20), ECB(6, 21)),
+          ECBlocks(28, ECB(7, 14), ECB(4, 15))),
+  Version(13, ALIGNMENT_PATTERN_CENTERS[12],
+          ECBlocks(26, ECB(4, 107)),
+          ECBlocks(22, ECB(8, 37), ECB(1, 38)),
+          ECBlocks(24, ECB(8, 20), ECB(4, 21)),
+          ECBlocks(22, ECB(12, 11), ECB(4, 12))),
+  Version(14, ALIGNMENT_PATTERN_CENTERS[13],
+          ECBlocks(30, ECB(3, 115), ECB(1, 116)),
+          ECBlocks(24, ECB(4, 40), ECB(5, 41)),
+          ECBlocks(20, ECB(11, 16), ECB(5, 17)),
+          ECBlocks(24, ECB(11, 12), ECB(5, 13))),
+  Version(15, ALIGNMENT_PATTERN_CENTERS[14],
+          ECBlocks(22, ECB(5, 87), ECB(1, 88)),
+          ECBlocks(24, ECB(5, 41), ECB(5, 42)),
+          ECBlocks(30, ECB(5, 24), ECB(7, 25)),
+          ECBlocks(24, ECB(11, 12), ECB(7, 13))),
+  Version(16, ALIGNMENT_PATTERN_CENTERS[15],
+          ECBlocks(24, ECB(5, 98), ECB(1, 99)),
+          ECBlocks(28, ECB(7, 45), ECB(3, 46)),
+          ECBlocks(24, ECB(15, 19), ECB(2, 20)),
+          ECBlocks(30, ECB(3, 15), ECB(13, 16))),
+  Version(17, ALIGNMENT_PATTERN_CENTERS[16],
+          ECBlocks(28, ECB(1, 107), ECB(5, 108)),
+          ECBlocks(28, ECB(10, 46), ECB(1, 47)),
+          ECBlocks(28, ECB(1, 22), ECB(15, 23)),
+          ECBlocks(28, ECB(2, 14), ECB(17, 15))),
+  Version(18, ALIGNMENT_PATTERN_CENTERS[17],
+          ECBlocks(30, ECB(5, 120), ECB(1, 121)),
+          ECBlocks(26, ECB(9, 43), ECB(4, 44)),
+          ECBlocks(28, ECB(17, 22), ECB(1, 23)),
+          ECBlocks(28, ECB(2, 14), ECB(19, 15))),
+  Version(19, ALIGNMENT_PATTERN_CENTERS[18],
+          ECBlocks(28, ECB(3, 113), ECB(4, 114)),
+          ECBlocks(26, ECB(3, 44), ECB(11, 45)),
+          ECBlocks(26, ECB(17, 21), ECB(4, 22)),
+          ECBlocks(26, ECB(9, 13), ECB(16, 14))),
+  Version(20, ALIGNMENT_PATTERN_CENTERS[19],
+          ECBlocks(28, ECB(3, 107), ECB(5, 108)),
+          ECBlocks(26, ECB(3, 41), ECB(13, 42)),
+          ECBlocks(30, ECB(15, 24), ECB(5, 25)),
+          ECBlocks(28, ECB(15, 15), ECB(10, 16))),
+  Version(21, ALIGNMENT_PATTERN_CENTERS[20],
+          ECBlocks(28, ECB(4, 116), ECB(4, 117)),
+          ECBlocks(26, ECB(17, 42)),
+          ECBlocks(28, ECB(17, 22), ECB(6, 23)),
+          ECBlocks(30, ECB(19, 16), ECB(6, 17))),
+  Version(22, ALIGNMENT_PATTERN_CENTERS[21],
+          ECBlocks(28, ECB(2, 111), ECB(7, 112)),
+          ECBlocks(28, ECB(17, 46)),
+          ECBlocks(30, ECB(7, 24), ECB(16, 25)),
+          ECBlocks(24, ECB(34, 13))),
+  Version(23, ALIGNMENT_PATTERN_CENTERS[22],
+          ECBlocks(30, ECB(4, 121), ECB(5, 122)),
+          ECBlocks(28, ECB(4, 47), ECB(14, 48)),
+          ECBlocks(30, ECB(11, 24), ECB(14, 25)),
+          ECBlocks(30, ECB(16, 15), ECB(14, 16))),
+  Version(24, ALIGNMENT_PATTERN_CENTERS[23],
+          ECBlocks(30, ECB(6, 117), ECB(4, 118)),
+          ECBlocks(28, ECB(6, 45), ECB(14, 46)),
+          ECBlocks(30, ECB(11, 24), ECB(16, 25)),
+          ECBlocks(30, ECB(30, 16), ECB(2, 17))),
+  Version(25, ALIGNMENT_PATTERN_CENTERS[24],
+          ECBlocks(26, ECB(8, 106), ECB(4, 107)),
+          ECBlocks(28, ECB(8, 47), ECB(13, 48)),
+          ECBlocks(30, ECB(7, 24), ECB(22, 25)),
+          ECBlocks(30, ECB(22, 15), ECB(13, 16))),
+  Version(26, ALIGNMENT_PATTERN_CENTERS[25],
+          ECBlocks(28, ECB(10, 114), ECB(2, 115)),
+          ECBlocks(28, ECB(19, 46), ECB(4, 47)),
+          ECBlocks(28, ECB(28, 22), ECB(6, 23)),
+          ECBlocks(30, ECB(33, 16), ECB(4, 17))),
+  Version(27, ALIGNMENT_PATTERN_CENTERS[26],
+          ECBlocks(30, ECB(8, 122), ECB(4, 123)),
+          ECBlocks(28, ECB(22, 45), ECB(3, 46)),
+          ECBlocks(30, ECB(8, 23), ECB(26, 24)),
+          ECBlocks(30, ECB(12, 15), ECB(28, 16))),
+  Version(28, ALIGNMENT_PATTERN_CENTERS[27],
+          ECBlocks(30, ECB(3, 117), ECB(10, 118)),
+          ECBlocks(28, ECB(3, 45), ECB(23, 46)),
+          ECBlocks(30, ECB(4, 24), ECB(31, 25)),
+          ECBlocks(30, ECB(11, 15), ECB(31, 16))),
+  Version(29, ALIGNMENT_PATTERN_CENTERS[28],
+          ECBlocks(30, ECB(7, 116), ECB(7, 117)),
+          ECBlocks(28, ECB(21, 45), ECB(7, 46)),
+          ECBlocks(30, ECB(1, 23), ECB(37, 24)),
+          ECBlocks(30, ECB(19, 15), ECB(26, 16))),
+  Version(30, ALIGNMENT_PATTERN_CENTERS[29],
+          ECBlocks(30, ECB(5, 115), ECB(10, 116)),
+          ECBlocks(28, ECB(19, 47), ECB(10, 48)),
+          ECBlocks(30, ECB(15, 24), ECB(25, 25)),
+          ECBlocks(30, ECB(23, 15), ECB(25, 16))),
+  Version(31, ALIGNMENT_PATTERN_CENTERS[30],
+          ECBlocks(30, ECB(13, 115), ECB(3, 116)),
+          ECBlocks(28, ECB(2, 46), ECB(29, 47)),
+          ECBlocks(30, ECB(42, 24), ECB(1, 25)),
+          ECBlocks(30, ECB(23, 15), ECB(28, 16))),
+  Version(32, ALIGNMENT_PATTERN_CENTERS[31],
+          ECBlocks(30, ECB(17, 115)),
+          ECBlocks(28, ECB(10, 46), ECB(23, 47)),
+          ECBlocks(30, ECB(10, 24), ECB(35, 25)),
+          ECBlocks(30, ECB(19, 15), ECB(35, 16))),
+  Version(33, ALIGNMENT_PATTERN_CENTERS[32],
+          ECBlocks(30, ECB(17, 115), ECB(1, 116)),
+          ECBlocks(28, ECB(14, 46), ECB(21, 47)),
+          ECBlocks(30, ECB(29, 24), ECB(19, 25)),
+          ECBlocks(30, ECB(11, 15), ECB(46, 16))),
+  Version(34, ALIGNMENT_PATTERN_CENTERS[33],
+          ECBlocks(30, ECB(13, 115), ECB(6, 116)),
+          ECBlocks(28, ECB(14, 46), ECB(23, 47)),
+          ECBlocks(30, ECB(44, 24), ECB(7, 25)),
+          ECBlocks(30, ECB(59, 16), ECB(1, 17))),
+  Version(35, ALIGNMENT_PATTERN_CENTERS[34],
+          ECBlocks(30, ECB(12, 121), ECB(7, 122)),
+          ECBlocks(28, ECB(12, 47), ECB(26, 48)),
+          ECBlocks(30, ECB(39, 24), ECB(14, 25)),
+          ECBlocks(30, ECB(22, 15), ECB(41, 16))),
+  Version(36, ALIGNMENT_PATTERN_CENTERS[35],
+          ECBlocks(30, ECB(6, 121), ECB(14, 122)),
+          ECBlocks(28, ECB(6, 47), ECB(34, 48)),
+          ECBlocks(30, ECB(46, 24), ECB(10, 25)),
+          ECBlocks(30, ECB(2, 15), ECB(64, 16))),
+  Version(37, ALIGNMENT_PATTERN_CENTERS[36],
+          ECBlocks(30, ECB(17, 122), ECB(4, 123)),
+          ECBlocks(28, ECB(29, 46), ECB(14, 47)),
+          ECBlocks(30, ECB(49, 24), ECB(10, 25)),
+          ECBlocks(30, ECB(24, 15), ECB(46, 16))),
+  Version(38, ALIGNMENT_PATTERN_CENTERS[37],
+          ECBlocks(30, ECB(4, 122), ECB(18, 123)),
+          ECBlocks(28, ECB(13, 46), ECB(32, 47)),
+          ECBlocks(30, ECB(48, 24), ECB(14, 25)),
+          ECBlocks(30, ECB(42, 15), ECB(32, 16))),
+  Version(39, ALIGNMENT_PATTERN_CENTERS[38],
+          ECBlocks(30, ECB(20, 117), ECB(4, 118)),
+          ECBlocks(28, ECB(40, 47), ECB(7, 48)),
+          ECBlocks(30, ECB(43, 24), ECB(22, 25)),
+          ECBlocks(30, ECB(10, 15), ECB(67, 16))),
+  Version(40, ALIGNMENT_PATTERN_CENTERS[39],
+          ECBlocks(30, ECB(19, 118), ECB(6, 119)),
+          ECBlocks(28, ECB(18, 47), ECB(31, 48)),
+          ECBlocks(30, ECB(34, 24), ECB(34, 25)),
+          ECBlocks(30, ECB(20, 15), ECB(61, 16)))
+};
+const int Version::N_VERSIONS = sizeof(VERSIONS) / sizeof(VERSIONS[0]);
 
 int Version::getVersionNumber() const {
   return versionNumber_;
 }
 
-vector<int> &Version::getAlignmentPatternCenters() {
-  return alignmentPatternCenters_;
+int Version::getAlignmentPatternCount() const {
+  return alignmentPatternCenters_[0];
 }
 
-int Version::getTotalCodewords() {
+int Version::getAlignmentPatternCenter(int i) const {
+  return alignmentPatternCenters_[i + 1];
+}
+
+int Version::getTotalCodewords() const {
   return totalCodewords_;
 }
 
-int Version::getDimensionForVersion() {
+int Version::getDimensionForVersion() const {
   return 17 + 4 * versionNumber_;
 }
 
-ECBlocks& Version::getECBlocksForLevel(const ErrorCorrectionLevel &ecLevel) const {
-  return *ecBlocks_[ecLevel.ordinal()];
+const ECBlocks& Version::getECBlocksForLevel(const ErrorCorrectionLevel &ecLevel) const {
+  return ecBlocks_[ecLevel.ordinal()];
 }
 
-Ref<Version> Version::getProvisionalVersionForDimension(int dimension) {
+const Version *Version::getProvisionalVersionForDimension(int dimension) {
   if (dimension % 4 != 1) {
     throw FormatException();
   }
@@ -113,48 +348,26 @@ Ref<Version> Version::getProvisionalVersionForDimension(int dimension) {
   }
 }
 
-Ref<Version> Version::getVersionForNumber(int versionNumber) {
+const Version *Version::getVersionForNumber(int versionNumber) {
   if (versionNumber < 1 || versionNumber > N_VERSIONS) {
     throw ReaderException("versionNumber must be between 1 and 40");
   }
 
-  return VERSIONS[versionNumber - 1];
+  return &VERSIONS[versionNumber - 1];
 }
 
-Version::Version(int versionNumber, vector<int> *alignmentPatternCenters, ECBlocks *ecBlocks1, ECBlocks *ecBlocks2,
-                 ECBlocks *ecBlocks3, ECBlocks *ecBlocks4) :
-    versionNumber_(versionNumber), alignmentPatternCenters_(*alignmentPatternCenters), ecBlocks_(4), totalCodewords_(0) {
-  ecBlocks_[0] = ecBlocks1;
-  ecBlocks_[1] = ecBlocks2;
-  ecBlocks_[2] = ecBlocks3;
-  ecBlocks_[3] = ecBlocks4;
-
-  int total = 0;
-  int ecCodewords = ecBlocks1->getECCodewordsPerBloc();
-  vector<ECB*> &ecbArray = ecBlocks1->getECBlocks();
-  for (size_t i = 0; i < ecbArray.size(); i++) {
-    ECB *ecBlock = ecbArray[i];
-    total += ecBlock->getCount() * (ecBlock->getDataCodewords() + ecCodewords);
+const Version *Version::decodeVersionInformation(unsigned int versionBits) {
+  // The top 6 of the 18 version info bits are the version number itself,
+  // so an undamaged codeword is found without searching
+  unsigned int versionNumber = versionBits >> 12;
+  if (versionNumber >= 7 && versionNumber < 7 + N_VERSION_DECODE_INFOS &&
+      VERSION_DECODE_INFO[versionNumber - 7] == versionBits) {
+    return getVersionForNumber(versionNumber);
   }
-  totalCodewords_ = total;
-}
-
-Version::~Version() {
-  delete &alignmentPatternCenters_;
-  for (size_t i = 0; i < ecBlocks_.size(); i++) {
-    delete ecBlocks_[i];
-  }
-}
-
-Ref<Version> Version::decodeVersionInformation(unsigned int versionBits) {
   int bestDifference = numeric_limits<int>::max();
   size_t bestVersion = 0;
   for (int i = 0; i < N_VERSION_DECODE_INFOS; i++) {
     unsigned targetVersion = VERSION_DECODE_INFO[i];
-    // Do the version info bits match exactly? done.
-    if (targetVersion == versionBits) {
-      return getVersionForNumber(i + 7);
-    }
     // Otherwise see if this is the closest to a real version info bit
     // string we have seen so far
     int bitsDifference = FormatInformation::numBitsDiffering(versionBits, targetVersion);
@@ -169,10 +382,10 @@ Ref<Version> Version::decodeVersionInformation(unsigned int versionBits) {
     return getVersionForNumber(bestVersion);
   }
   // If we didn't find a close enough match, fail
-  return Ref<Version>(NULL);
+  return 0;
 }
 
-Ref<BitMatrix> Version::buildFunctionPattern() {
+Ref<BitMatrix> Version::buildFunctionPattern() const {
   int dimension = getDimensionForVersion();
   Ref<BitMatrix> functionPattern(new BitMatrix(dimension));
 
@@ -186,15 +399,15 @@ Ref<BitMatrix> Version::buildFunctionPattern() {
 
 
   // Alignment patterns
-  size_t max = alignmentPatternCenters_.size();
-  for (size_t x = 0; x < max; x++) {
-    int i = alignmentPatternCenters_[x] - 2;
-    for (size_t y = 0; y < max; y++) {
+  int max = getAlignmentPatternCount();
+  for (int x = 0; x < max; x++) {
+    int i = getAlignmentPatternCenter(x) - 2;
+    for (int y = 0; y < max; y++) {
       if ((x == 0 && (y == 0 || y == max - 1)) || (x == max - 1 && y == 0)) {
         // No alignment patterns near the three finder patterns
         continue;
       }
-      functionPattern->setRegion(alignmentPatternCenters_[y] - 2, i, 5, 5);
+      functionPattern->setRegion(getAlignmentPatternCenter(y) - 2, i, 5, 5);
     }
   }
 
@@ -213,354 +426,5 @@ Ref<BitMatrix> Version::buildFunctionPattern() {
   return functionPattern;
 }
 
-static vector<int> *intArray(size_t n...) {
-  va_list ap;
-  va_start(ap, n);
-  vector<int> *result = new vector<int>(n);
-  for (size_t i = 0; i < n; i++) {
-    (*result)[i] = va_arg(ap, int);
-  }
-  va_end(ap);
-  return result;
-}
-
-int Version::buildVersions() {
-  VERSIONS.push_back(Ref<Version>(new Version(1, intArray(0),
-                                  new ECBlocks(7, new ECB(1, 19)),
-                                  new ECBlocks(10, new ECB(1, 16)),
-                                  new ECBlocks(13, new ECB(1, 13)),
-                                  new ECBlocks(17, new ECB(1, 9)))));
-  VERSIONS.push_back(Ref<Version>(new Version(2, intArray(2, 6, 18),
-                                  new ECBlocks(10, new ECB(1, 34)),
-                                  new ECBlocks(16, new ECB(1, 28)),
-                                  new ECBlocks(22, new ECB(1, 22)),
-                                  new ECBlocks(28, new ECB(1, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(3, intArray(2, 6, 22),
-                                  new ECBlocks(15, new ECB(1, 55)),
-                                  new ECBlocks(26, new ECB(1, 44)),
-                                  new ECBlocks(18, new ECB(2, 17)),
-                                  new ECBlocks(22, new ECB(2, 13)))));
-  VERSIONS.push_back(Ref<Version>(new Version(4, intArray(2, 6, 26),
-                                  new ECBlocks(20, new ECB(1, 80)),
-                                  new ECBlocks(18, new ECB(2, 32)),
-                                  new ECBlocks(26, new ECB(2, 24)),
-                                  new ECBlocks(16, new ECB(4, 9)))));
-  VERSIONS.push_back(Ref<Version>(new Version(5, intArray(2, 6, 30),
-                                  new ECBlocks(26, new ECB(1, 108)),
-                                  new ECBlocks(24, new ECB(2, 43)),
-                                  new ECBlocks(18, new ECB(2, 15),
-                                               new ECB(2, 16)),
-                                  new ECBlocks(22, new ECB(2, 11),
-                                               new ECB(2, 12)))));
-  VERSIONS.push_back(Ref<Version>(new Version(6, intArray(2, 6, 34),
-                                  new ECBlocks(18, new ECB(2, 68)),
-                                  new ECBlocks(16, new ECB(4, 27)),
-                                  new ECBlocks(24, new ECB(4, 19)),
-                                  new ECBlocks(28, new ECB(4, 15)))));
-  VERSIONS.push_back(Ref<Version>(new Version(7, intArray(3, 6, 22, 38),
-                                  new ECBlocks(20, new ECB(2, 78)),
-                                  new ECBlocks(18, new ECB(4, 31)),
-                                  new ECBlocks(18, new ECB(2, 14),
-                                               new ECB(4, 15)),
-                                  new ECBlocks(26, new ECB(4, 13),
-                                               new ECB(1, 14)))));
-  VERSIONS.push_back(Ref<Version>(new Version(8, intArray(3, 6, 24, 42),
-                                  new ECBlocks(24, new ECB(2, 97)),
-                                  new ECBlocks(22, new ECB(2, 38),
-                                               new ECB(2, 39)),
-                                  new ECBlocks(22, new ECB(4, 18),
-                                               new ECB(2, 19)),
-                                  new ECBlocks(26, new ECB(4, 14),
-                                               new ECB(2, 15)))));
-  VERSIONS.push_back(Ref<Version>(new Version(9, intArray(3, 6, 26, 46),
-                                  new ECBlocks(30, new ECB(2, 116)),
-                                  new ECBlocks(22, new ECB(3, 36),
-                                               new ECB(2, 37)),
-                                  new ECBlocks(20, new ECB(4, 16),
-                                               new ECB(4, 17)),
-                                  new ECBlocks(24, new ECB(4, 12),
-                                               new ECB(4, 13)))));
-  VERSIONS.push_back(Ref<Version>(new Version(10, intArray(3, 6, 28, 50),
-                                  new ECBlocks(18, new ECB(2, 68),
-                                               new ECB(2, 69)),
-                                  new ECBlocks(26, new ECB(4, 43),
-                                               new ECB(1, 44)),
-                                  new ECBlocks(24, new ECB(6, 19),
-                                               new ECB(2, 20)),
-                                  new ECBlocks(28, new ECB(6, 15),
-                                               new ECB(2, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(11, intArray(3, 6, 30, 54),
-                                  new ECBlocks(20, new ECB(4, 81)),
-                                  new ECBlocks(30, new ECB(1, 50),
-                                               new ECB(4, 51)),
-                                  new ECBlocks(28, new ECB(4, 22),
-                                               new ECB(4, 23)),
-                                  new ECBlocks(24, new ECB(3, 12),
-                                               new ECB(8, 13)))));
-  VERSIONS.push_back(Ref<Version>(new Version(12, intArray(3, 6, 32, 58),
-                                  new ECBlocks(24, new ECB(2, 92),
-                                               new ECB(2, 93)),
-                                  new ECBlocks(22, new ECB(6, 36),
-                                               new ECB(2, 37)),
-                                  new ECBlocks(26, new ECB(4, 20),
-                                               new ECB(6, 21)),
-                                  new ECBlocks(28, new ECB(7, 14),
-                                               new ECB(4, 15)))));
-  VERSIONS.push_back(Ref<Version>(new Version(13, intArray(3, 6, 34, 62),
-                                  new ECBlocks(26, new ECB(4, 107)),
-                                  new ECBlocks(22, new ECB(8, 37),
-                                               new ECB(1, 38)),
-                                  new ECBlocks(24, new ECB(8, 20),
-                                               new ECB(4, 21)),
-                                  new ECBlocks(22, new ECB(12, 11),
-                                               new ECB(4, 12)))));
-  VERSIONS.push_back(Ref<Version>(new Version(14, intArray(4, 6, 26, 46, 66),
-                                  new ECBlocks(30, new ECB(3, 115),
-                                               new ECB(1, 116)),
-                                  new ECBlocks(24, new ECB(4, 40),
-                                               new ECB(5, 41)),
-                                  new ECBlocks(20, new ECB(11, 16),
-                                               new ECB(5, 17)),
-                                  new ECBlocks(24, new ECB(11, 12),
-                                               new ECB(5, 13)))));
-  VERSIONS.push_back(Ref<Version>(new Version(15, intArray(4, 6, 26, 48, 70),
-                                  new ECBlocks(22, new ECB(5, 87),
-                                               new ECB(1, 88)),
-                                  new ECBlocks(24, new ECB(5, 41),
-                                               new ECB(5, 42)),
-                                  new ECBlocks(30, new ECB(5, 24),
-                                               new ECB(7, 25)),
-                                  new ECBlocks(24, new ECB(11, 12),
-                                               new ECB(7, 13)))));
-  VERSIONS.push_back(Ref<Version>(new Version(16, intArray(4, 6, 26, 50, 74),
-                                  new ECBlocks(24, new ECB(5, 98),
-                                               new ECB(1, 99)),
-                                  new ECBlocks(28, new ECB(7, 45),
-                                               new ECB(3, 46)),
-                                  new ECBlocks(24, new ECB(15, 19),
-                                               new ECB(2, 20)),
-                                  new ECBlocks(30, new ECB(3, 15),
-                                               new ECB(13, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(17, intArray(4, 6, 30, 54, 78),
-                                  new ECBlocks(28, new ECB(1, 107),
-                                               new ECB(5, 108)),
-                                  new ECBlocks(28, new ECB(10, 46),
-                                               new ECB(1, 47)),
-                                  new ECBlocks(28, new ECB(1, 22),
-                                               new ECB(15, 23)),
-                                  new ECBlocks(28, new ECB(2, 14),
-                                               new ECB(17, 15)))));
-  VERSIONS.push_back(Ref<Version>(new Version(18, intArray(4, 6, 30, 56, 82),
-                                  new ECBlocks(30, new ECB(5, 120),
-                                               new ECB(1, 121)),
-                                  new ECBlocks(26, new ECB(9, 43),
-                                               new ECB(4, 44)),
-                                  new ECBlocks(28, new ECB(17, 22),
-                                               new ECB(1, 23)),
-                                  new ECBlocks(28, new ECB(2, 14),
-                                               new ECB(19, 15)))));
-  VERSIONS.push_back(Ref<Version>(new Version(19, intArray(4, 6, 30, 58, 86),
-                                  new ECBlocks(28, new ECB(3, 113),
-                                               new ECB(4, 114)),
-                                  new ECBlocks(26, new ECB(3, 44),
-                                               new ECB(11, 45)),
-                                  new ECBlocks(26, new ECB(17, 21),
-                                               new ECB(4, 22)),
-                                  new ECBlocks(26, new ECB(9, 13),
-                                               new ECB(16, 14)))));
-  VERSIONS.push_back(Ref<Version>(new Version(20, intArray(4, 6, 34, 62, 90),
-                                  new ECBlocks(28, new ECB(3, 107),
-                                               new ECB(5, 108)),
-                                  new ECBlocks(26, new ECB(3, 41),
-                                               new ECB(13, 42)),
-                                  new ECBlocks(30, new ECB(15, 24),
-                                               new ECB(5, 25)),
-                                  new ECBlocks(28, new ECB(15, 15),
-                                               new ECB(10, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(21, intArray(5, 6, 28, 50, 72, 94),
-                                  new ECBlocks(28, new ECB(4, 116),
-                                               new ECB(4, 117)),
-                                  new ECBlocks(26, new ECB(17, 42)),
-                                  new ECBlocks(28, new ECB(17, 22),
-                                               new ECB(6, 23)),
-                                  new ECBlocks(30, new ECB(19, 16),
-                                               new ECB(6, 17)))));
-  VERSIONS.push_back(Ref<Version>(new Version(22, intArray(5, 6, 26, 50, 74, 98),
-                                  new ECBlocks(28, new ECB(2, 111),
-                                               new ECB(7, 112)),
-                                  new ECBlocks(28, new ECB(17, 46)),
-                                  new ECBlocks(30, new ECB(7, 24),
-                                               new ECB(16, 25)),
-                                  new ECBlocks(24, new ECB(34, 13)))));
-  VERSIONS.push_back(Ref<Version>(new Version(23, intArray(5, 6, 30, 54, 78, 102),
-                                  new ECBlocks(30, new ECB(4, 121),
-                                               new ECB(5, 122)),
-                                  new ECBlocks(28, new ECB(4, 47),
-                                               new ECB(14, 48)),
-                                  new ECBlocks(30, new ECB(11, 24),
-                                               new ECB(14, 25)),
-                                  new ECBlocks(30, new ECB(16, 15),
-                                               new ECB(14, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(24, intArray(5, 6, 28, 54, 80, 106),
-                                  new ECBlocks(30, new ECB(6, 117),
-                                               new ECB(4, 118)),
-                                  new ECBlocks(28, new ECB(6, 45),
-                                               new ECB(14, 46)),
-                                  new ECBlocks(30, new ECB(11, 24),
-                                               new ECB(16, 25)),
-                                  new ECBlocks(30, new ECB(30, 16),
-                                               new ECB(2, 17)))));
-  VERSIONS.push_back(Ref<Version>(new Version(25, intArray(5, 6, 32, 58, 84, 110),
-                                  new ECBlocks(26, new ECB(8, 106),
-                                               new ECB(4, 107)),
-                                  new ECBlocks(28, new ECB(8, 47),
-                                               new ECB(13, 48)),
-                                  new ECBlocks(30, new ECB(7, 24),
-                                               new ECB(22, 25)),
-                                  new ECBlocks(30, new ECB(22, 15),
-                                               new ECB(13, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(26, intArray(5, 6, 30, 58, 86, 114),
-                                  new ECBlocks(28, new ECB(10, 114),
-                                               new ECB(2, 115)),
-                                  new ECBlocks(28, new ECB(19, 46),
-                                               new ECB(4, 47)),
-                                  new ECBlocks(28, new ECB(28, 22),
-                                               new ECB(6, 23)),
-                                  new ECBlocks(30, new ECB(33, 16),
-                                               new ECB(4, 17)))));
-  VERSIONS.push_back(Ref<Version>(new Version(27, intArray(5, 6, 34, 62, 90, 118),
-                                  new ECBlocks(30, new ECB(8, 122),
-                                               new ECB(4, 123)),
-                                  new ECBlocks(28, new ECB(22, 45),
-                                               new ECB(3, 46)),
-                                  new ECBlocks(30, new ECB(8, 23),
-                                               new ECB(26, 24)),
-                                  new ECBlocks(30, new ECB(12, 15),
-                                               new ECB(28, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(28, intArray(6, 6, 26, 50, 74, 98, 122),
-                                  new ECBlocks(30, new ECB(3, 117),
-                                               new ECB(10, 118)),
-                                  new ECBlocks(28, new ECB(3, 45),
-                                               new ECB(23, 46)),
-                                  new ECBlocks(30, new ECB(4, 24),
-                                               new ECB(31, 25)),
-                                  new ECBlocks(30, new ECB(11, 15),
-                                               new ECB(31, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(29, intArray(6, 6, 30, 54, 78, 102, 126),
-                                  new ECBlocks(30, new ECB(7, 116),
-                                               new ECB(7, 117)),
-                                  new ECBlocks(28, new ECB(21, 45),
-                                               new ECB(7, 46)),
-                                  new ECBlocks(30, new ECB(1, 23),
-                                               new ECB(37, 24)),
-                                  new ECBlocks(30, new ECB(19, 15),
-                                               new ECB(26, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(30, intArray(6, 6, 26, 52, 78, 104, 130),
-                                  new ECBlocks(30, new ECB(5, 115),
-                                               new ECB(10, 116)),
-                                  new ECBlocks(28, new ECB(19, 47),
-                                               new ECB(10, 48)),
-                                  new ECBlocks(30, new ECB(15, 24),
-                                               new ECB(25, 25)),
-                                  new ECBlocks(30, new ECB(23, 15),
-                                               new ECB(25, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(31, intArray(6, 6, 30, 56, 82, 108, 134),
-                                  new ECBlocks(30, new ECB(13, 115),
-                                               new ECB(3, 116)),
-                                  new ECBlocks(28, new ECB(2, 46),
-                                               new ECB(29, 47)),
-                                  new ECBlocks(30, new ECB(42, 24),
-                                               new ECB(1, 25)),
-                                  new ECBlocks(30, new ECB(23, 15),
-                                               new ECB(28, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(32, intArray(6, 6, 34, 60, 86, 112, 138),
-                                  new ECBlocks(30, new ECB(17, 115)),
-                                  new ECBlocks(28, new ECB(10, 46),
-                                               new ECB(23, 47)),
-                                  new ECBlocks(30, new ECB(10, 24),
-                                               new ECB(35, 25)),
-                                  new ECBlocks(30, new ECB(19, 15),
-                                               new ECB(35, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(33, intArray(6, 6, 30, 58, 86, 114, 142),
-                                  new ECBlocks(30, new ECB(17, 115),
-                                               new ECB(1, 116)),
-                                  new ECBlocks(28, new ECB(14, 46),
-                                               new ECB(21, 47)),
-                                  new ECBlocks(30, new ECB(29, 24),
-                                               new ECB(19, 25)),
-                                  new ECBlocks(30, new ECB(11, 15),
-                                               new ECB(46, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(34, intArray(6, 6, 34, 62, 90, 118, 146),
-                                  new ECBlocks(30, new ECB(13, 115),
-                                               new ECB(6, 116)),
-                                  new ECBlocks(28, new ECB(14, 46),
-                                               new ECB(23, 47)),
-                                  new ECBlocks(30, new ECB(44, 24),
-                                               new ECB(7, 25)),
-                                  new ECBlocks(30, new ECB(59, 16),
-                                               new ECB(1, 17)))));
-  VERSIONS.push_back(Ref<Version>(new Version(35, intArray(7, 6, 30, 54, 78,
-                                  102, 126, 150),
-                                  new ECBlocks(30, new ECB(12, 121),
-                                               new ECB(7, 122)),
-                                  new ECBlocks(28, new ECB(12, 47),
-                                               new ECB(26, 48)),
-                                  new ECBlocks(30, new ECB(39, 24),
-                                               new ECB(14, 25)),
-                                  new ECBlocks(30, new ECB(22, 15),
-                                               new ECB(41, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(36, intArray(7, 6, 24, 50, 76,
-                                  102, 128, 154),
-                                  new ECBlocks(30, new ECB(6, 121),
-                                               new ECB(14, 122)),
-                                  new ECBlocks(28, new ECB(6, 47),
-                                               new ECB(34, 48)),
-                                  new ECBlocks(30, new ECB(46, 24),
-                                               new ECB(10, 25)),
-                                  new ECBlocks(30, new ECB(2, 15),
-                                               new ECB(64, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(37, intArray(7, 6, 28, 54, 80,
-                                  106, 132, 158),
-                                  new ECBlocks(30, new ECB(17, 122),
-                                               new ECB(4, 123)),
-                                  new ECBlocks(28, new ECB(29, 46),
-                                               new ECB(14, 47)),
-                                  new ECBlocks(30, new ECB(49, 24),
-                                               new ECB(10, 25)),
-                                  new ECBlocks(30, new ECB(24, 15),
-                                               new ECB(46, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(38, intArray(7, 6, 32, 58, 84,
-                                  110, 136, 162),
-                                  new ECBlocks(30, new ECB(4, 122),
-                                               new ECB(18, 123)),
-                                  new ECBlocks(28, new ECB(13, 46),
-                                               new ECB(32, 47)),
-                                  new ECBlocks(30, new ECB(48, 24),
-                                               new ECB(14, 25)),
-                                  new ECBlocks(30, new ECB(42, 15),
-                                               new ECB(32, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(39, intArray(7, 6, 26, 54, 82,
-                                  110, 138, 166),
-                                  new ECBlocks(30, new ECB(20, 117),
-                                               new ECB(4, 118)),
-                                  new ECBlocks(28, new ECB(40, 47),
-                                               new ECB(7, 48)),
-                                  new ECBlocks(30, new ECB(43, 24),
-                                               new ECB(22, 25)),
-                                  new ECBlocks(30, new ECB(10, 15),
-                                               new ECB(67, 16)))));
-  VERSIONS.push_back(Ref<Version>(new Version(40, intArray(7, 6, 30, 58, 86,
-                                  114, 142, 170),
-                                  new ECBlocks(30, new ECB(19, 118),
-                                               new ECB(6, 119)),
-                                  new ECBlocks(28, new ECB(18, 47),
-                                               new ECB(31, 48)),
-                                  new ECBlocks(30, new ECB(34, 24),
-                                               new ECB(34, 25)),
-                                  new ECBlocks(30, new ECB(20, 15),
-                                               new ECB(61, 16)))));
-  return VERSIONS.size();
-}
-
 }
 }
@@ -20,65 +20,87 @@
  * limitations under the License.
  */
 
-#include <zxing/common/Counted.h>
 #include <zxing/qrcode/ErrorCorrectionLevel.h>
 #include <zxing/ReaderException.h>
 #include <zxing/common/BitMatrix.h>
 #include <zxing/common/Counted.h>
-#include <vector>
 
 namespace zxing {
 namespace qrcode {
 
 class ECB {
 private:
+  friend class ECBlocks;
   int count_;
   int dataCodewords_;
 public:
-  ECB(int count, int dataCodewords);
-  int getCount();
-  int getDataCodewords();
+  constexpr ECB(int count, int dataCodewords) :
+      count_(count), dataCodewords_(dataCodewords) {
+  }
+  int getCount() const;
+  int getDataCodewords() const;
 };
 
 class ECBlocks {
 private:
   int ecCodewordsPerBloc_;
-  std::vector<ECB*> ecBlocks_;
+  int numECBlocks_;
+  ECB ecBlocks_[2];
 public:
-  ECBlocks(int ecCodewordsPerBloc, ECB *ecBlocks);
-  ECBlocks(int ecCodewordsPerBloc, ECB *ecBlocks1, ECB *ecBlocks2);
-  int getECCodewordsPerBloc();
-  int getTotalECCodewords();
-  std::vector<ECB*>& getECBlocks();
-  ~ECBlocks();
+  constexpr ECBlocks(int ecCodewordsPerBloc, ECB ecBlocks) :
+      ecCodewordsPerBloc_(ecCodewordsPerBloc), numECBlocks_(1), ecBlocks_{ecBlocks, ECB(0, 0)} {
+  }
+  constexpr ECBlocks(int ecCodewordsPerBloc, ECB ecBlocks1, ECB ecBlocks2) :
+      ecCodewordsPerBloc_(ecCodewordsPerBloc), numECBlocks_(2), ecBlocks_{ecBlocks1, ecBlocks2} {
+  }
+  // Unused ECB slots count zero blocks, so they add nothing here
+  constexpr int getTotalCodewords() const {
+    return ecBlocks_[0].count_ * (ecBlocks_[0].dataCodewords_ + ecCodewordsPerBloc_) +
+        ecBlocks_[1].count_ * (ecBlocks_[1].dataCodewords_ + ecCodewordsPerBloc_);
+  }
+  int getECCodewordsPerBloc() const;
+  int getTotalECCodewords() const;
+  int getNumECBlocks() const;
+  const ECB &getECBlock(int i) const;
 };
 
-class Version : public Counted {
+/**
+ * The QR Code versions are a table of constants, laid out by the compiler:
+ * nothing is built at static initialization time and looking a version up
+ * is an array access. Versions are never freed, so plain pointers to them
+ * are safe to keep.
+ */
+class Version {
 
 private:
   int versionNumber_;
-  std::vector<int> &alignmentPatternCenters_;
-  std::vector<ECBlocks*> ecBlocks_;
+  // Count of alignment pattern centers followed by the centers themselves
+  const int *alignmentPatternCenters_;
+  ECBlocks ecBlocks_[4];
   int totalCodewords_;
-  Version(int versionNumber, std::vector<int> *alignmentPatternCenters, ECBlocks *ecBlocks1, ECBlocks *ecBlocks2,
-          ECBlocks *ecBlocks3, ECBlocks *ecBlocks4);
+  constexpr Version(int versionNumber, const int *alignmentPatternCenters, ECBlocks ecBlocks1, ECBlocks ecBlocks2,
+                    ECBlocks ecBlocks3, ECBlocks ecBlocks4) :
+      versionNumber_(versionNumber), alignmentPatternCenters_(alignmentPatternCenters),
+      ecBlocks_{ecBlocks1, ecBlocks2, ecBlocks3, ecBlocks4}, totalCodewords_(ecBlocks1.getTotalCodewords()) {
+  }
+
+  static const Version VERSIONS[];
+  static const int N_VERSIONS;
 
 public:
-  static unsigned int VERSION_DECODE_INFO[];
-  static int N_VERSION_DECODE_INFOS;
-  static std::vector<Ref<Version> > VERSIONS;
+  static const unsigned int VERSION_DECODE_INFO[];
+  static const int N_VERSION_DECODE_INFOS;
 
-  ~Version();
   int getVersionNumber() const;
-  std::vector<int> &getAlignmentPatternCenters();
-  int getTotalCodewords();
-  int getDimensionForVersion();
-  ECBlocks &getECBlocksForLevel(const ErrorCorrectionLevel &ecLevel) const;
-  static Ref<Version> getProvisionalVersionForDimension(int dimension);
-  static Ref<Version> getVersionForNumber(int versionNumber);
-  static Ref<Version> decodeVersionInformation(unsigned int versionBits);
-  Ref<BitMatrix> buildFunctionPattern();
-  static int buildVersions();
+  int getAlignmentPatternCount() const;
+  int getAlignmentPatternCenter(int i) const;
+  int getTotalCodewords() const;
+  int getDimensionForVersion() const;
+  const ECBlocks &getECBlocksForLevel(const ErrorCorrectionLevel &ecLevel) const;
+  static const Version *getProvisionalVersionForDimension(int dimension);
+  static const Version *getVersionForNumber(int versionNumber);
+  static const Version *decodeVersionInformation(unsigned int versionBits);
+  Ref<BitMatrix> buildFunctionPattern() const;
 };
 }
 }
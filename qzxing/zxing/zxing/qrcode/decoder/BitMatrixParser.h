@@ -33,7 +33,7 @@ namespace qrcode {
 class BitMatrixParser : public Counted {
 private:
   Ref<BitMatrix> bitMatrix_;
-  Version *parsedVersion_;
+  const Version *parsedVersion_;
   Ref<FormatInformation> parsedFormatInfo_;
 
   int copyBit(size_t x, size_t y, int versionBits);
@@ -41,7 +41,7 @@ private:
 public:
   BitMatrixParser(Ref<BitMatrix> bitMatrix);
   Ref<FormatInformation> readFormatInformation();
-  Version *readVersion();
+  const Version *readVersion();
   ArrayRef<char> readCodewords();
 
 private:
@@ -38,7 +38,7 @@ private:
 
 public:
   static std::vector<Ref<DataBlock> >
-  getDataBlocks(ArrayRef<char> rawCodewords, Version *version, ErrorCorrectionLevel &ecLevel);
+  getDataBlocks(ArrayRef<char> rawCodewords, const Version *version, ErrorCorrectionLevel &ecLevel);
 
   int getNumDataCodewords();
   ArrayRef<char> getCodewords();
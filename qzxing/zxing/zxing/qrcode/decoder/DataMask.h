@@ -33,6 +33,16 @@ class DataMask : public Counted {
 private:
   static std::vector<Ref<DataMask> > DATA_MASKS;
 
+  /**
+   * Every mask repeats after 12 rows (the row periods are 2, 3, 4 and 6), so
+   * it is stored as 12 rows of words wide enough for a version 40 symbol and
+   * applied to a whole row at a time.
+   */
+  static const int PATTERN_ROWS = 12;
+  static const int PATTERN_WORDS = (177 + 31) / 32;
+  std::vector<int> pattern_;
+  void buildPattern();
+
 protected:
 
 public:
@@ -61,7 +61,7 @@ private:
 
 public:
   static Ref<DecoderResult> decode(ArrayRef<char> bytes,
-                                   Version *version,
+                                   const Version *version,
                                    ErrorCorrectionLevel const& ecLevel,
                                    Hashtable const& hints);
 };
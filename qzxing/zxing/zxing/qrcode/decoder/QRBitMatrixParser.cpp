@@ -20,6 +20,8 @@
 
 #include <zxing/qrcode/decoder/BitMatrixParser.h>
 #include <zxing/qrcode/decoder/DataMask.h>
+#include <algorithm>
+#include <vector>
 
 
 namespace zxing {
@@ -74,7 +76,7 @@ Ref<FormatInformation> BitMatrixParser::readFormatInformation() {
   throw ReaderException("Could not decode format information");
 }
 
-Version *BitMatrixParser::readVersion() {
+const Version *BitMatrixParser::readVersion() {
   if (parsedVersion_ != 0) {
     return parsedVersion_;
   }
@@ -118,7 +120,7 @@ Version *BitMatrixParser::readVersion() {
 
 ArrayRef<char> BitMatrixParser::readCodewords() {
   Ref<FormatInformation> formatInfo = readFormatInformation();
-  Version *version = readVersion();
+  const Version *version = readVersion();
 
 
   // Get the data mask for the format used in this QR Code. This will exclude
@@ -137,10 +139,23 @@ ArrayRef<char> BitMatrixParser::readCodewords() {
 
   //	cout << *functionPattern << endl;
 
+  // Copy both matrices out a row of words at a time, the zigzag below then
+  // takes each pair of columns out of one word instead of module by module
+  int words = (dimension + 31) >> 5;
+  std::vector<int> dataWords(dimension * words);
+  std::vector<int> functionWords(dimension * words);
+  Ref<BitArray> row;
+  for (int y = 0; y < dimension; y++) {
+    row = bitMatrix_->getRow(y, row);
+    std::copy(row->getBitArray().begin(), row->getBitArray().begin() + words, dataWords.begin() + y * words);
+    row = functionPattern->getRow(y, row);
+    std::copy(row->getBitArray().begin(), row->getBitArray().begin() + words, functionWords.begin() + y * words);
+  }
+
   bool readingUp = true;
   ArrayRef<char> result(version->getTotalCodewords());
   int resultOffset = 0;
-  int currentByte = 0;
+  unsigned bitBuffer = 0;
   int bitsRead = 0;
   // Read columns in pairs, from right to left
   for (int x = dimension - 1; x > 0; x -= 2) {
@@ -149,25 +164,35 @@ ArrayRef<char> BitMatrixParser::readCodewords() {
       // saves time and makes the other code proceed more cleanly
       x--;
     }
+    int word = x >> 5;
+    int shift = x & 0x1f;
     // Read alternatingly from bottom to top then top to bottom
     for (int counter = 0; counter < dimension; counter++) {
       int y = readingUp ? dimension - 1 - counter : counter;
-      for (int col = 0; col < 2; col++) {
-        // Ignore bits covered by the function pattern
-        if (!functionPattern->get(x - col, y)) {
-          // Read a bit
-          bitsRead++;
-          currentByte <<= 1;
-          if (bitMatrix_->get(x - col, y)) {
-            currentByte |= 1;
-          }
-          // If we've made a whole byte, save it off
-          if (bitsRead == 8) {
-            result[resultOffset++] = (char)currentByte;
-            bitsRead = 0;
-            currentByte = 0;
-          }
-        }
+      const unsigned *dataRow = (const unsigned *)&dataWords[y * words];
+      const unsigned *functionRow = (const unsigned *)&functionWords[y * words];
+      // Column x in bit 1 and column x - 1 in bit 0, which is in the
+      // previous word when x starts a word
+      unsigned pair, functionPair;
+      if (shift > 0) {
+        pair = (dataRow[word] >> (shift - 1)) & 3;
+        functionPair = (functionRow[word] >> (shift - 1)) & 3;
+      } else {
+        pair = ((dataRow[word] & 1) << 1) | (dataRow[word - 1] >> 31);
+        functionPair = ((functionRow[word] & 1) << 1) | (functionRow[word - 1] >> 31);
+      }
+      // Ignore bits covered by the function pattern
+      if (functionPair == 0) {
+        bitBuffer = (bitBuffer << 2) | pair;
+        bitsRead += 2;
+      } else if (functionPair != 3) {
+        bitBuffer = (bitBuffer << 1) | ((pair >> (functionPair & 1)) & 1);
+        bitsRead++;
+      }
+      // At most two bits come in at a time, so at most one byte is complete
+      if (bitsRead >= 8) {
+        bitsRead -= 8;
+        result[resultOffset++] = (char)(bitBuffer >> bitsRead);
       }
     }
     readingUp = !readingUp; // switch directions
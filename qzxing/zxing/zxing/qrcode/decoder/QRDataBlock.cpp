@@ -39,29 +39,28 @@ ArrayRef<char> DataBlock::getCodewords() {
 }
 
 
-std::vector<Ref<DataBlock> > DataBlock::getDataBlocks(ArrayRef<char> rawCodewords, Version *version,
+std::vector<Ref<DataBlock> > DataBlock::getDataBlocks(ArrayRef<char> rawCodewords, const Version *version,
     ErrorCorrectionLevel &ecLevel) {
 
 
   // Figure out the number and size of data blocks used by this version and
   // error correction level
-  ECBlocks &ecBlocks = version->getECBlocksForLevel(ecLevel);
+  const ECBlocks &ecBlocks = version->getECBlocksForLevel(ecLevel);
 
 
   // First count the total number of data blocks
   int totalBlocks = 0;
-  vector<ECB*> ecBlockArray = ecBlocks.getECBlocks();
-  for (size_t i = 0; i < ecBlockArray.size(); i++) {
-    totalBlocks += ecBlockArray[i]->getCount();
+  for (int i = 0; i < ecBlocks.getNumECBlocks(); i++) {
+    totalBlocks += ecBlocks.getECBlock(i).getCount();
   }
 
   // Now establish DataBlocks of the appropriate size and number of data codewords
   std::vector<Ref<DataBlock> > result(totalBlocks);
   int numResultBlocks = 0;
-  for (size_t j = 0; j < ecBlockArray.size(); j++) {
-    ECB *ecBlock = ecBlockArray[j];
-    for (int i = 0; i < ecBlock->getCount(); i++) {
-      int numDataCodewords = ecBlock->getDataCodewords();
+  for (int j = 0; j < ecBlocks.getNumECBlocks(); j++) {
+    const ECB &ecBlock = ecBlocks.getECBlock(j);
+    for (int i = 0; i < ecBlock.getCount(); i++) {
+      int numDataCodewords = ecBlock.getDataCodewords();
       int numBlockCodewords = ecBlocks.getECCodewordsPerBloc() + numDataCodewords;
       ArrayRef<char> buffer(numBlockCodewords);
       Ref<DataBlock> blockRef(new DataBlock(numDataCodewords, buffer));
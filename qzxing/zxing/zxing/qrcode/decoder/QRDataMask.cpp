@@ -21,6 +21,7 @@
 #include <zxing/qrcode/decoder/DataMask.h>
 
 #include <zxing/common/IllegalArgumentException.h>
+#include <zxing/common/BitArray.h>
 
 namespace zxing {
 namespace qrcode {
@@ -43,17 +44,38 @@ DataMask &DataMask::forReference(int reference) {
   return *DATA_MASKS[reference];
 }
 
-void DataMask::unmaskBitMatrix(BitMatrix& bits, size_t dimension) {
-  for (size_t y = 0; y < dimension; y++) {
-    for (size_t x = 0; x < dimension; x++) {
+void DataMask::buildPattern() {
+  pattern_.assign(PATTERN_ROWS * PATTERN_WORDS, 0);
+  for (int y = 0; y < PATTERN_ROWS; y++) {
+    for (int x = 0; x < PATTERN_WORDS * 32; x++) {
       // TODO: check why the coordinates have to be swapped
       if (isMasked(y, x)) {
-        bits.flip(x, y);
+        pattern_[y * PATTERN_WORDS + (x >> 5)] |= 1 << (x & 0x1f);
       }
     }
   }
 }
 
+void DataMask::unmaskBitMatrix(BitMatrix& bits, size_t dimension) {
+  int words = (int)(dimension + 31) >> 5;
+  if (words > PATTERN_WORDS) {
+    throw IllegalArgumentException("Dimension too large for a QR code");
+  }
+  // Leave the padding after the last module alone
+  int lastWord = (dimension & 0x1f) != 0 ? (1 << (dimension & 0x1f)) - 1 : -1;
+  Ref<BitArray> row;
+  for (size_t y = 0; y < dimension; y++) {
+    row = bits.getRow((int)y, row);
+    std::vector<int>& rowBits = row->getBitArray();
+    const int* pattern = &pattern_[(y % PATTERN_ROWS) * PATTERN_WORDS];
+    for (int i = 0; i < words - 1; i++) {
+      rowBits[i] ^= pattern[i];
+    }
+    rowBits[words - 1] ^= pattern[words - 1] & lastWord;
+    bits.setRow((int)y, row);
+  }
+}
+
 /**
  * 000: mask bits for which (x + y) mod 2 == 0
  */
@@ -152,6 +174,9 @@ int DataMask::buildDataMasks() {
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask101()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask110()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask111()));
+  for (size_t i = 0; i < DATA_MASKS.size(); i++) {
+    DATA_MASKS[i]->buildPattern();
+  }
   return DATA_MASKS.size();
 }
 
@@ -24,8 +24,11 @@
 #include <zxing/FormatException.h>
 #include <zxing/common/StringUtils.h>
 #include <iostream>
+#include <cstring>
 #ifndef NO_ICONV
 #include <iconv.h>
+#include <cerrno>
+#include <map>
 #endif
 
 // Required for compatibility. TODO : test on Symbian
@@ -54,6 +57,52 @@ const char DecodedBitStreamParser::ALPHANUMERIC_CHARS[] =
 
 namespace {int GB2312_SUBSET = 1;}
 
+#ifndef NO_ICONV
+namespace {
+/**
+ * Conversion descriptors to UTF-8 by source charset. Opening one costs more
+ * than decoding a small QR code, and the descriptors cannot be shared between
+ * threads.
+ */
+class IconvCache {
+ private:
+  std::map<std::string, iconv_t> descriptors_;
+
+ public:
+  ~IconvCache() {
+    for (std::map<std::string, iconv_t>::iterator it = descriptors_.begin(); it != descriptors_.end(); ++it) {
+      if (it->second != (iconv_t)-1) {
+        iconv_close(it->second);
+      }
+    }
+  }
+
+  iconv_t get(const char *src) {
+    std::map<std::string, iconv_t>::iterator it = descriptors_.find(src);
+    if (it == descriptors_.end()) {
+      it = descriptors_.insert(std::make_pair(std::string(src), iconv_open(StringUtils::UTF8, src))).first;
+    } else if (it->second != (iconv_t)-1) {
+      // Back to the initial shift state after an earlier failed conversion
+      iconv(it->second, 0, 0, 0, 0);
+    }
+    return it->second;
+  }
+};
+
+// Each thread keeps its descriptors when the toolchain runs the destructors of
+// thread_local objects at thread exit. Older Android NDK and MinGW toolchains
+// lack them or leak there, so a cache only lives for one conversion instead.
+// Define ZXING_NO_THREAD_LOCAL to do the same on other toolchains.
+#if !defined(ZXING_NO_THREAD_LOCAL) && (defined(__ANDROID__) || defined(__MINGW32__))
+#define ZXING_NO_THREAD_LOCAL
+#endif
+
+#ifndef ZXING_NO_THREAD_LOCAL
+thread_local IconvCache iconvCache;
+#endif
+}
+#endif
+
 void DecodedBitStreamParser::append(std::string &result,
                                     string const& in,
                                     const char *src) {
@@ -69,38 +118,54 @@ void DecodedBitStreamParser::append(std::string &result,
         return;
     }
 
-    iconv_t cd = iconv_open(StringUtils::UTF8, src);
+    // Nothing to convert when the bytes already are what UTF-8 would be
+    if (StringUtils::isAsciiCompatible(src)
+            && StringUtils::asciiPrefixLength(bufIn, (int)nIn) == (int)nIn
+            && memchr(bufIn, 0, nIn) == 0) {
+        result.append(bufIn, nIn);
+        return;
+    }
+    if ((strcmp(src, StringUtils::UTF8) == 0 || strcmp(src, "UTF8") == 0)
+            && StringUtils::isValidUTF8(bufIn, (int)nIn)
+            && memchr(bufIn, 0, nIn) == 0) {
+        result.append(bufIn, nIn);
+        return;
+    }
+
+#ifdef ZXING_NO_THREAD_LOCAL
+    IconvCache iconvCache;
+#endif
+    iconv_t cd = iconvCache.get(src);
     if (cd == (iconv_t)-1) {
         result.append((const char *)bufIn, nIn);
         return;
     }
 
-    const int maxOut = 4 * nIn + 1;
-    char* bufOut = new char[maxOut];
-
+    char bufOut[256];
     ICONV_CONST char *fromPtr = (ICONV_CONST char *)bufIn;
     size_t nFrom = nIn;
-    char *toPtr = (char *)bufOut;
-    size_t nTo = maxOut;
+    size_t converted = result.length();
 
     while (nFrom > 0) {
+        char *toPtr = bufOut;
+        size_t nTo = sizeof(bufOut);
 #if defined(Q_OS_SYMBIAN)
-    size_t oneway = iconv(cd,(const char**) &fromPtr, &nFrom, &toPtr, &nTo);
+        size_t oneway = iconv(cd,(const char**) &fromPtr, &nFrom, &toPtr, &nTo);
 #else
-    size_t oneway = iconv(cd,(char**) &fromPtr, &nFrom, &toPtr, &nTo);
+        size_t oneway = iconv(cd,(char**) &fromPtr, &nFrom, &toPtr, &nTo);
 #endif
-        if (oneway == (size_t)(-1)) {
-            iconv_close(cd);
-            delete[] bufOut;
+        result.append(bufOut, sizeof(bufOut) - nTo);
+        if (oneway == (size_t)(-1) && errno != E2BIG) {
+            result.resize(converted);
             throw ReaderException("error converting characters");
         }
     }
-    iconv_close(cd);
 
-    int nResult = maxOut - nTo;
-    bufOut[nResult] = '\0';
-    result.append((const char *)bufOut);
-    delete[] bufOut;
+    // The output used to be appended as a C string, so it stops at a NUL
+    size_t nul = result.find('\0', converted);
+    if (nul != std::string::npos) {
+        result.resize(nul);
+    }
 #else
     Q_UNUSED(src);
     result.append((const char *)bufIn, nIn);
@@ -351,7 +416,7 @@ int parseECIValue(BitSource& bits) {
 
 Ref<DecoderResult>
 DecodedBitStreamParser::decode(ArrayRef<char> bytes,
-                               Version* version,
+                               const Version* version,
                                ErrorCorrectionLevel const& ecLevel,
                                Hashtable const& hints) {
     Ref<BitSource> bits_ (new BitSource(bytes));
@@ -67,7 +67,7 @@ Ref<DecoderResult> Decoder::decode(Ref<BitMatrix> bits) {
 
   // std::cerr << *bits << std::endl;
 
-  Version *version = parser.readVersion();
+  const Version *version = parser.readVersion();
   ErrorCorrectionLevel &ecLevel = parser.readFormatInformation()->getErrorCorrectionLevel();
 
 
@@ -36,6 +36,7 @@ private:
   static int MAX_MODULES;
 
   Ref<BitMatrix> image_;
+  Ref<BitMatrix> transposed_;
   std::vector<AlignmentPattern *> *possibleCenters_;
   int startX_;
   int startY_;
@@ -48,11 +49,16 @@ private:
 
   float crossCheckVertical(int startI, int centerJ, int maxCount, int originalStateCountTotal);
 
+  bool getVertical(int x, int y) const {
+    return transposed_ ? transposed_->get(y, x) : image_->get(x, y);
+  }
+
   Ref<AlignmentPattern> handlePossibleCenter(std::vector<int> &stateCount, int i, int j);
 
 public:
   AlignmentPatternFinder(Ref<BitMatrix> image, int startX, int startY, int width, int height,
-                         float moduleSize, Ref<ResultPointCallback>const& callback);
+                         float moduleSize, Ref<ResultPointCallback>const& callback,
+                         Ref<BitMatrix> transposed = Ref<BitMatrix>());
   ~AlignmentPatternFinder();
   Ref<AlignmentPattern> find();
   
@@ -38,6 +38,7 @@ namespace qrcode {
 class Detector : public Counted {
 private:
   Ref<BitMatrix> image_;
+  Ref<BitMatrix> transposed_;
   Ref<ResultPointCallback> callback_;
 
 protected:
@@ -61,6 +62,13 @@ public:
   Detector(Ref<BitMatrix> image);
   Ref<DetectorResult> detect(DecodeHints const& hints);
 
+  /**
+   * Like detect(), but only looks for the finder patterns close to the
+   * previous ones, the first three points of an earlier DetectorResult.
+   * Throws a ReaderException if any of them can't be found again.
+   */
+  Ref<DetectorResult> track(ArrayRef< Ref<ResultPoint> > previous, DecodeHints const& hints);
+
 
 };
 }
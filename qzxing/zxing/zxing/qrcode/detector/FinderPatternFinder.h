@@ -41,8 +41,11 @@ private:
 protected:
   static int MIN_SKIP;
   static int MAX_MODULES;
+  static int TRANSPOSE_CROSS_CHECK_AREA;
 
   Ref<BitMatrix> image_;
+  Ref<BitMatrix> transposed_;
+  int verticalCrossChecks_;
   std::vector<Ref<FinderPattern> > possibleCenters_;
   bool hasSkipped_;
 
@@ -54,6 +57,11 @@ protected:
   static bool foundPatternCross(int* stateCount);
 
   float crossCheckVertical(size_t startI, size_t centerJ, int maxCount, int originalStateCountTotal);
+
+  /** image_->get(x, y), read from the transposed image once it has been built */
+  bool getVertical(size_t x, int y) const {
+    return transposed_ ? transposed_->get(y, (int)x) : image_->get((int)x, y);
+  }
   float crossCheckHorizontal(size_t startJ, size_t centerI, int maxCount, int originalStateCountTotal);
 
   /** stateCount must be int[5] */
@@ -73,6 +81,19 @@ public:
   static float distance(Ref<ResultPoint> p1, Ref<ResultPoint> p2);
   FinderPatternFinder(Ref<BitMatrix> image, Ref<ResultPointCallback>const&);
   Ref<FinderPatternInfo> find(DecodeHints const& hints);
+
+  /**
+   * Re-confirms a finder pattern seen at previous in an earlier frame by
+   * cross-checking only a few start points within two modules of it.
+   * Returns NULL if there is no finder pattern there any more.
+   */
+  Ref<FinderPattern> findNear(Ref<ResultPoint> previous, float moduleSize);
+
+  /**
+   * The transposed image built for the vertical cross-checks, NULL when
+   * there were too few of them to make it worthwhile.
+   */
+  Ref<BitMatrix> getTransposedImage() const;
 };
 }
 }
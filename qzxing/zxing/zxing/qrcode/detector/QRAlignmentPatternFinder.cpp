@@ -55,7 +55,7 @@ float AlignmentPatternFinder::crossCheckVertical(int startI, int centerJ, int ma
 
   // Start counting up from center
   int i = startI;
-  while (i >= 0 && image_->get(centerJ, i) && stateCount[1] <= maxCount) {
+  while (i >= 0 && getVertical(centerJ, i) && stateCount[1] <= maxCount) {
     stateCount[1]++;
     i--;
   }
@@ -63,7 +63,7 @@ float AlignmentPatternFinder::crossCheckVertical(int startI, int centerJ, int ma
   if (i < 0 || stateCount[1] > maxCount) {
     return nan();
   }
-  while (i >= 0 && !image_->get(centerJ, i) && stateCount[0] <= maxCount) {
+  while (i >= 0 && !getVertical(centerJ, i) && stateCount[0] <= maxCount) {
     stateCount[0]++;
     i--;
   }
@@ -73,14 +73,14 @@ float AlignmentPatternFinder::crossCheckVertical(int startI, int centerJ, int ma
 
   // Now also count down from center
   i = startI + 1;
-  while (i < maxI && image_->get(centerJ, i) && stateCount[1] <= maxCount) {
+  while (i < maxI && getVertical(centerJ, i) && stateCount[1] <= maxCount) {
     stateCount[1]++;
     i++;
   }
   if (i == maxI || stateCount[1] > maxCount) {
     return nan();
   }
-  while (i < maxI && !image_->get(centerJ, i) && stateCount[2] <= maxCount) {
+  while (i < maxI && !getVertical(centerJ, i) && stateCount[2] <= maxCount) {
     stateCount[2]++;
     i++;
   }
@@ -124,8 +124,9 @@ Ref<AlignmentPattern> AlignmentPatternFinder::handlePossibleCenter(vector<int> &
 
 AlignmentPatternFinder::AlignmentPatternFinder(Ref<BitMatrix> image, int startX, int startY, int width,
                                                int height, float moduleSize, 
-                                               Ref<ResultPointCallback>const& callback) :
-    image_(image), possibleCenters_(new vector<AlignmentPattern *> ()), startX_(startX), startY_(startY),
+                                               Ref<ResultPointCallback>const& callback,
+                                               Ref<BitMatrix> transposed) :
+    image_(image), transposed_(transposed), possibleCenters_(new vector<AlignmentPattern *> ()), startX_(startX), startY_(startY),
     width_(width), height_(height), moduleSize_(moduleSize), callback_(callback) {
 }
 
@@ -36,6 +36,7 @@ using std::ostringstream;
 using std::abs;
 using std::min;
 using std::max;
+using std::vector;
 using zxing::qrcode::Detector;
 using zxing::Ref;
 using zxing::BitMatrix;
@@ -49,6 +50,7 @@ using zxing::common::detector::MathUtils;
 using zxing::DecodeHints;
 using zxing::qrcode::FinderPatternFinder;
 using zxing::qrcode::FinderPatternInfo;
+using zxing::qrcode::FinderPattern;
 using zxing::ResultPoint;
 
 Detector::Detector(Ref<BitMatrix> image) :
@@ -67,9 +69,33 @@ Ref<DetectorResult> Detector::detect(DecodeHints const& hints) {
   callback_ = hints.getResultPointCallback();
   FinderPatternFinder finder(image_, hints.getResultPointCallback());
   Ref<FinderPatternInfo> info(finder.find(hints));
+  // Reuse the finder's transposed image, if any, for the alignment pattern
+  transposed_ = finder.getTransposedImage();
   return processFinderPatternInfo(info);
 }
 
+Ref<DetectorResult> Detector::track(ArrayRef< Ref<ResultPoint> > previous, DecodeHints const& hints) {
+  if (previous->size() < 3) {
+    throw zxing::ReaderException("Nothing to track");
+  }
+  callback_ = hints.getResultPointCallback();
+  // The points are ordered bottom left, top left, top right like the finder patterns
+  float moduleSize = calculateModuleSize(previous[1], previous[2], previous[0]);
+  if (isnan_z(moduleSize) || moduleSize < 1.0f) {
+    throw zxing::ReaderException("Lost track of the finder patterns");
+  }
+  FinderPatternFinder finder(image_, callback_);
+  vector< Ref<FinderPattern> > patterns(3);
+  for (int i = 0; i < 3; i++) {
+    patterns[i] = finder.findNear(previous[i], moduleSize);
+    if (patterns[i] == 0) {
+      throw zxing::ReaderException("Lost track of the finder patterns");
+    }
+  }
+  transposed_ = finder.getTransposedImage();
+  return processFinderPatternInfo(Ref<FinderPatternInfo>(new FinderPatternInfo(patterns)));
+}
+
 Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> info){
   Ref<FinderPattern> topLeft(info->getTopLeft());
   Ref<FinderPattern> topRight(info->getTopRight());
@@ -80,12 +106,12 @@ Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> in
     throw zxing::ReaderException("bad module size");
   }
   int dimension = computeDimension(topLeft, topRight, bottomLeft, moduleSize);
-  Version *provisionalVersion = Version::getProvisionalVersionForDimension(dimension);
+  const Version *provisionalVersion = Version::getProvisionalVersionForDimension(dimension);
   int modulesBetweenFPCenters = provisionalVersion->getDimensionForVersion() - 7;
 
   Ref<AlignmentPattern> alignmentPattern;
   // Anything above version 1 has an alignment pattern
-  if (provisionalVersion->getAlignmentPatternCenters().size() > 0) {
+  if (provisionalVersion->getAlignmentPatternCount() > 0) {
 
 
     // Guess where a "bottom right" finder pattern would have been
@@ -310,6 +336,7 @@ Ref<AlignmentPattern> Detector::findAlignmentInRegion(float overallEstModuleSize
   }
 
   AlignmentPatternFinder alignmentFinder(image_, alignmentAreaLeftX, alignmentAreaTopY, alignmentAreaRightX
-                                         - alignmentAreaLeftX, alignmentAreaBottomY - alignmentAreaTopY, overallEstModuleSize, callback_);
+                                         - alignmentAreaLeftX, alignmentAreaBottomY - alignmentAreaTopY, overallEstModuleSize, callback_,
+                                         transposed_);
   return alignmentFinder.find();
 }
@@ -80,6 +80,7 @@ public:
 int FinderPatternFinder::CENTER_QUORUM = 2;
 int FinderPatternFinder::MIN_SKIP = 3;
 int FinderPatternFinder::MAX_MODULES = 57;
+int FinderPatternFinder::TRANSPOSE_CROSS_CHECK_AREA = 256;
 
 float FinderPatternFinder::centerFromEnd(int* stateCount, int end) {
   return (float)(end - stateCount[4] - stateCount[3]) - stateCount[2] / 2.0f;
@@ -106,6 +107,14 @@ bool FinderPatternFinder::foundPatternCross(int* stateCount) {
 
 float FinderPatternFinder::crossCheckVertical(size_t startI, size_t centerJ, int maxCount, int originalStateCountTotal) {
 
+  // With many candidates the column walks are cheaper as row walks over a
+  // transposed copy. Building it costs about as much as one cross-check per
+  // TRANSPOSE_CROSS_CHECK_AREA pixels, so only do it once that many were made.
+  if (!transposed_ &&
+      ++verticalCrossChecks_ * TRANSPOSE_CROSS_CHECK_AREA > image_->getWidth() * image_->getHeight()) {
+    transposed_ = image_->transpose();
+  }
+
   int maxI = image_->getHeight();
   int stateCount[5] = {0};
 //  for (int i = 0; i < 5; i++)
@@ -114,14 +123,14 @@ float FinderPatternFinder::crossCheckVertical(size_t startI, size_t centerJ, int
 
   // Start counting up from center
   int i = startI;
-  while (i >= 0 && image_->get(centerJ, i)) {
+  while (i >= 0 && getVertical(centerJ, i)) {
     stateCount[2]++;
     i--;
   }
   if (i < 0) {
     return nan();
   }
-  while (i >= 0 && !image_->get(centerJ, i) && stateCount[1] <= maxCount) {
+  while (i >= 0 && !getVertical(centerJ, i) && stateCount[1] <= maxCount) {
     stateCount[1]++;
     i--;
   }
@@ -129,7 +138,7 @@ float FinderPatternFinder::crossCheckVertical(size_t startI, size_t centerJ, int
   if (i < 0 || stateCount[1] > maxCount) {
     return nan();
   }
-  while (i >= 0 && image_->get(centerJ, i) && stateCount[0] <= maxCount) {
+  while (i >= 0 && getVertical(centerJ, i) && stateCount[0] <= maxCount) {
     stateCount[0]++;
     i--;
   }
@@ -139,21 +148,21 @@ float FinderPatternFinder::crossCheckVertical(size_t startI, size_t centerJ, int
 
   // Now also count down from center
   i = startI + 1;
-  while (i < maxI && image_->get(centerJ, i)) {
+  while (i < maxI && getVertical(centerJ, i)) {
     stateCount[2]++;
     i++;
   }
   if (i == maxI) {
     return nan();
   }
-  while (i < maxI && !image_->get(centerJ, i) && stateCount[3] < maxCount) {
+  while (i < maxI && !getVertical(centerJ, i) && stateCount[3] < maxCount) {
     stateCount[3]++;
     i++;
   }
   if (i == maxI || stateCount[3] >= maxCount) {
     return nan();
   }
-  while (i < maxI && image_->get(centerJ, i) && stateCount[4] < maxCount) {
+  while (i < maxI && getVertical(centerJ, i) && stateCount[4] < maxCount) {
     stateCount[4]++;
     i++;
   }
@@ -426,7 +435,7 @@ float FinderPatternFinder::distance(Ref<ResultPoint> p1, Ref<ResultPoint> p2) {
 
 FinderPatternFinder::FinderPatternFinder(Ref<BitMatrix> image,
                                            Ref<ResultPointCallback>const& callback) :
-    image_(image), possibleCenters_(), hasSkipped_(false), callback_(callback) {
+    image_(image), verticalCrossChecks_(0), possibleCenters_(), hasSkipped_(false), callback_(callback) {
 }
 
 Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
@@ -462,67 +471,66 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
 
     memset(stateCount, 0, sizeof(stateCount));
     int currentState = 0;
-    for (size_t j = 0; j < maxJ; j++) {
-      if (matrix.get(j, i)) {
-        // Black pixel
+    // Walk the row one run of equal pixels at a time. The state machine only
+    // changes state on colour changes, so this counts exactly like a pixel by
+    // pixel scan, while long runs of one colour are skipped a word at a time.
+    size_t j = 0;
+    while (j < maxJ) {
+      bool black = matrix.get(j, i);
+      size_t end = black ? matrix.getNextUnset(j, i) : matrix.getNextSet(j, i);
+      int run = (int)(end - j);
+      if (black) {
         if ((currentState & 1) == 1) { // Counting white pixels
           currentState++;
         }
-        stateCount[currentState]++;
-      } else { // White pixel
-        if ((currentState & 1) == 0) { // Counting black pixels
-          if (currentState == 4) { // A winner?
-            if (foundPatternCross(stateCount)) { // Yes
-              bool confirmed = handlePossibleCenter(stateCount, i, j);
-              if (confirmed) {
-                // Start examining every other line. Checking each line turned out to be too
-                // expensive and didn't improve performance.
-                iSkip = 2;
-                if (hasSkipped_) {
-                  done = haveMultiplyConfirmedCenters();
-                } else {
-                  int rowSkip = findRowSkip();
-                  if (rowSkip > stateCount[2]) {
-                    // Skip rows between row of lower confirmed center
-                    // and top of presumed third confirmed center
-                    // but back up a bit to get a full chance of detecting
-                    // it, entire width of center of finder pattern
-
-                    // Skip by rowSkip, but back off by stateCount[2] (size
-                    // of last center of pattern we saw) to be conservative,
-                    // and also back off by iSkip which is about to be
-                    // re-added
-                    i += rowSkip - stateCount[2] - iSkip;
-                    j = maxJ - 1;
-                  }
-                }
-              } else {
-                stateCount[0] = stateCount[2];
-                stateCount[1] = stateCount[3];
-                stateCount[2] = stateCount[4];
-                stateCount[3] = 1;
-                stateCount[4] = 0;
-                currentState = 3;
-                continue;
-              }
-              // Clear state to start looking again
-              currentState = 0;
-              memset(stateCount, 0, sizeof(stateCount));
-            } else { // No, shift counts back by two
-              stateCount[0] = stateCount[2];
-              stateCount[1] = stateCount[3];
-              stateCount[2] = stateCount[4];
-              stateCount[3] = 1;
-              stateCount[4] = 0;
-              currentState = 3;
-            }
+        stateCount[currentState] += run;
+      } else if ((currentState & 1) == 1) { // Counting white pixels
+        stateCount[currentState] += run;
+      } else if (currentState == 4) { // A winner?
+        if (foundPatternCross(stateCount) && handlePossibleCenter(stateCount, i, j)) { // Yes
+          // Start examining every other line. Checking each line turned out to be too
+          // expensive and didn't improve performance.
+          iSkip = 2;
+          bool skipRest = false;
+          if (hasSkipped_) {
+            done = haveMultiplyConfirmedCenters();
           } else {
-            stateCount[++currentState]++;
+            int rowSkip = findRowSkip();
+            if (rowSkip > stateCount[2]) {
+              // Skip rows between row of lower confirmed center
+              // and top of presumed third confirmed center
+              // but back up a bit to get a full chance of detecting
+              // it, entire width of center of finder pattern
+
+              // Skip by rowSkip, but back off by stateCount[2] (size
+              // of last center of pattern we saw) to be conservative,
+              // and also back off by iSkip which is about to be
+              // re-added
+              i += rowSkip - stateCount[2] - iSkip;
+              end = maxJ;
+              skipRest = true;
+            }
+          }
+          // Clear state to start looking again, the rest of this white run
+          // starts a new pattern
+          memset(stateCount, 0, sizeof(stateCount));
+          currentState = 0;
+          if (!skipRest && run > 1) {
+            currentState = 1;
+            stateCount[1] = run - 1;
           }
-        } else { // Counting white pixels
-          stateCount[currentState]++;
+        } else { // No, shift counts back by two
+          stateCount[0] = stateCount[2];
+          stateCount[1] = stateCount[3];
+          stateCount[2] = stateCount[4];
+          stateCount[3] = run;
+          stateCount[4] = 0;
+          currentState = 3;
         }
+      } else {
+        stateCount[++currentState] += run;
       }
+      j = end;
     }
     if (foundPatternCross(stateCount)) {
       bool confirmed = handlePossibleCenter(stateCount, i, maxJ);
@@ -543,10 +551,45 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
   return result;
 }
 
+Ref<FinderPattern> FinderPatternFinder::findNear(Ref<ResultPoint> previous, float moduleSize) {
+  // Any start point inside the 3x3 module center of the pattern will do, so
+  // stepping by one module finds a pattern that moved up to about 2.5 modules
+  static const int offsets[] = {0, -1, 1, -2, 2};
+  int maxCount = (int)ceil(3.0f * moduleSize);
+  int stateCountTotal = (int)(7.0f * moduleSize + 0.5f);
+  int maxI = image_->getHeight();
+  int maxJ = image_->getWidth();
+  for (int dy = 0; dy < 5; dy++) {
+    int startI = (int)(previous->getY() + offsets[dy] * moduleSize);
+    if (startI < 0 || startI >= maxI) {
+      continue;
+    }
+    for (int dx = 0; dx < 5; dx++) {
+      int startJ = (int)(previous->getX() + offsets[dx] * moduleSize);
+      if (startJ < 0 || startJ >= maxJ || !image_->get(startJ, startI)) {
+        continue;
+      }
+      float centerI = crossCheckVertical(startI, startJ, maxCount, stateCountTotal);
+      if (isnan_z(centerI)) {
+        continue;
+      }
+      float centerJ = crossCheckHorizontal(startJ, (size_t)centerI, maxCount, stateCountTotal);
+      if (!isnan_z(centerJ) && crossCheckDiagonal((int)centerI, (int)centerJ, maxCount, stateCountTotal)) {
+        return Ref<FinderPattern>(new FinderPattern(centerJ, centerI, moduleSize));
+      }
+    }
+  }
+  return Ref<FinderPattern>();
+}
+
 Ref<BitMatrix> FinderPatternFinder::getImage() {
   return image_;
 }
 
+Ref<BitMatrix> FinderPatternFinder::getTransposedImage() const {
+  return transposed_;
+}
+
 vector<Ref<FinderPattern> >& FinderPatternFinder::getPossibleCenters() {
     return possibleCenters_;
 }
@@ -2,14 +2,22 @@
 
 #include <zxing/common/GlobalHistogramBinarizer.h>
 #include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/AdaptiveThresholdBinarizer.h>
 #include <zxing/common/GreyscaleLuminanceSource.h>
 #include <zxing/Binarizer.h>
 #include <zxing/BinaryBitmap.h>
 #include <zxing/MultiFormatReader.h>
 #include <zxing/DecodeHints.h>
 #include <zxing/qrcode/ErrorCorrectionLevel.h>
+#include <zxing/datamatrix/DataMatrixReader.h>
+#include <zxing/aztec/AztecReader.h>
+#include <zxing/pdf417/PDF417Reader.h>
+#include <zxing/oned/MultiFormatOneDReader.h>
+#include <zxing/multi/qrcode/QRCodeMultiReader.h>
 
 #include <QCamera>
+#include <QPolygonF>
+#include <QSemaphore>
 #include <QTextCodec>
 #include <QDebug>
 #include <QtConcurrent/QtConcurrent>
@@ -17,34 +25,114 @@
 // #define DEBUG_FILTER
 // #define DEBUG_TIME
 
+// Symbologies read from the black matrix rather than row by row
+static const uint MATRIX_FORMATS = zxing::DecodeHints::QR_CODE_HINT | zxing::DecodeHints::DATA_MATRIX_HINT |
+        zxing::DecodeHints::AZTEC_HINT | zxing::DecodeHints::PDF_417_HINT;
+
+static const uint ONED_FORMATS = zxing::DecodeHints::CODABAR_HINT | zxing::DecodeHints::CODE_39_HINT |
+        zxing::DecodeHints::CODE_93_HINT | zxing::DecodeHints::CODE_128_HINT | zxing::DecodeHints::EAN_8_HINT |
+        zxing::DecodeHints::EAN_13_HINT | zxing::DecodeHints::ITF_HINT | zxing::DecodeHints::RSS_14_HINT |
+        zxing::DecodeHints::RSS_EXPANDED_HINT | zxing::DecodeHints::UPC_A_HINT | zxing::DecodeHints::UPC_E_HINT |
+        zxing::DecodeHints::UPC_EAN_EXTENSION_HINT;
+
+// Shared by the attempts racing on one frame, losers may still hold it after the frame is done
+struct BarcodeVideoFilterRunnable::RaceState
+{
+    RaceState() : winner(0), reported(0) { }
+
+    QAtomicInt winner;
+    QAtomicInt reported;
+    QSemaphore finished;
+};
+
 BarcodeVideoFilter::BarcodeVideoFilter(QAbstractVideoFilter *parent) :
     QAbstractVideoFilter(parent),
-    m_rotate(false)
+    m_enabledDecoders(0),
+    m_rotate(false),
+    m_binarizer(Binarizer_Hybrid),
+    m_reuseBlackPoints(false),
+    m_race(false),
+    m_tracking(false),
+    m_multipleCodes(false)
 {
 }
 
-BarcodeVideoFilterRunnable::BarcodeVideoFilterRunnable(BarcodeVideoFilter *parent, uint filters, bool rotate)
+BarcodeVideoFilterRunnable::BarcodeVideoFilterRunnable(BarcodeVideoFilter *parent, uint filters, uint decoders, bool rotate, uint binarizer, bool reuseBlackPoints, bool race, bool tracking, bool multipleCodes)
     : m_parent(parent)
 {
     m_decoder = new zxing::MultiFormatReader();
-    m_hints = new zxing::DecodeHints();
-    if (filters & BarCodeFormat_2D) {
-        qDebug("2D");
-        m_hints->addFormat(zxing::BarcodeFormat::QR_CODE);
-        m_hints->addFormat(zxing::BarcodeFormat::DATA_MATRIX);
+    // The per symbology selection uses the DecodeHints bit layout as is
+    m_formats=decoders & (MATRIX_FORMATS | ONED_FORMATS);
+    if (!m_formats) {
+        if (filters & BarCodeFormat_2D) {
+            qDebug("2D");
+            m_formats |= zxing::DecodeHints::QR_CODE_HINT | zxing::DecodeHints::DATA_MATRIX_HINT;
+        }
+        if (filters & BarCodeFormat_1D) {
+            qDebug("1D");
+            m_formats |= zxing::DecodeHints::CODE_39_HINT | zxing::DecodeHints::CODE_93_HINT |
+                    zxing::DecodeHints::CODE_128_HINT | zxing::DecodeHints::EAN_8_HINT | zxing::DecodeHints::EAN_13_HINT;
+        }
+        if (filters & BarCodeFormat_PDF417) {
+            qDebug("PDF417");
+            m_formats |= zxing::DecodeHints::PDF_417_HINT;
+        }
     }
-    if (filters & BarCodeFormat_1D) {
-        qDebug("1D");
-        m_hints->addFormat(zxing::BarcodeFormat::CODE_39);
-        m_hints->addFormat(zxing::BarcodeFormat::CODE_93);
-        m_hints->addFormat(zxing::BarcodeFormat::CODE_128);
-        m_hints->addFormat(zxing::BarcodeFormat::EAN_8);
-        m_hints->addFormat(zxing::BarcodeFormat::EAN_13);
+    m_hints = new zxing::DecodeHints(m_formats);
+    if (m_formats & (zxing::DecodeHints::QR_CODE_HINT | zxing::DecodeHints::DATA_MATRIX_HINT | zxing::DecodeHints::AZTEC_HINT)) {
+        // A symbol held in front of the camera samples to the same modules frame after frame
+        m_hints->setDecoderResultCache(zxing::Ref<zxing::DecoderResultCache>(new zxing::DecoderResultCache()));
     }
     //m_hints->setTryHarder(true); // XXX Do we need this ?
+    // With both 1D and 2D formats enabled, let the 1D readers use the same local thresholds as the 2D readers
+    m_localBlackRows=(m_formats & ONED_FORMATS) && (m_formats & MATRIX_FORMATS);
     m_rotate=rotate;
+    m_race=race;
+    m_multipleCodes=multipleCodes && (m_formats & zxing::DecodeHints::QR_CODE_HINT);
+    m_multiHints=0;
+    if (m_multipleCodes) {
+        // The multi QR pass reads every QR code, the normal pass is left with the other symbologies
+        m_multiHints=m_hints;
+        m_formats&=~zxing::DecodeHints::QR_CODE_HINT;
+        m_hints=new zxing::DecodeHints(m_formats);
+        m_hints->setDecoderResultCache(m_multiHints->getDecoderResultCache());
+    }
+    // Follow a QR code from frame to frame instead of searching the whole frame for it
+    if (tracking && (m_formats & zxing::DecodeHints::QR_CODE_HINT)) {
+        m_qrTracker=new zxing::qrcode::QRCodeReader();
+        m_qrTracker->setTracking(true);
+    }
+    m_binarizer=binarizer;
+    // Frames are scanned one at a time, so a single cache can follow the stream
+    if (reuseBlackPoints)
+        m_blackPointCache=new zxing::BlackPointCache();
     m_fhandler = new VideoFrameWrapper();
     m_tp=new QThreadPool();
+    // The race waits for its attempts from a m_tp thread, they need threads of their own
+    m_raceTp=race ? new QThreadPool() : 0;
+    // Same for the QR candidates of the multi pass
+    m_multiTp=m_multipleCodes ? new QThreadPool() : 0;
+}
+
+BarcodeVideoFilterRunnable::~BarcodeVideoFilterRunnable()
+{
+    // The frame still being scanned may start race attempts, wait for it first.
+    // Attempts that lost a race keep running after their frame and use the hints.
+    m_tp->waitForDone();
+    delete m_tp;
+    if (m_raceTp) {
+        m_raceTp->waitForDone();
+        delete m_raceTp;
+    }
+    if (m_multiTp) {
+        m_multiTp->waitForDone();
+        delete m_multiTp;
+    }
+
+    delete m_decoder;
+    delete m_hints;
+    delete m_multiHints;
+    delete m_fhandler;
 }
 
 QVideoFrame BarcodeVideoFilterRunnable::run(QVideoFrame *input, const QVideoSurfaceFormat &surfaceFormat, QVideoFilterRunnable::RunFlags flags)
@@ -114,55 +202,53 @@ bool BarcodeVideoFilterRunnable::scanBarcode(VideoFrameWrapper *ciw)
 
     const int w=ciw->getWidth();
     const int h=ciw->getHeight();
+    bool found=false;
 
     try {
         zxing::ArrayRef<char> arr = zxing::ArrayRef<char>((char *)ciw->getData(), w*h);
         zxing::Ref<zxing::LuminanceSource> source(new zxing::GreyscaleLuminanceSource(arr, w, h, 0, 0, w, h));
         //zxing::Ref<zxing::LuminanceSource> source(new zxing::GreyscaleLuminanceSource(arr, w, h, 0, h/3, w, h-h/3));
-        zxing::HybridBinarizer *binz = new zxing::HybridBinarizer(source);
-
-        Q_ASSERT(binz);
-
-        zxing::Ref<zxing::Binarizer> bz(binz);
+        zxing::Ref<zxing::Binarizer> bz=createBinarizer(source);
         zxing::BinaryBitmap *bb = new zxing::BinaryBitmap(bz);
 
         Q_ASSERT(bb);
 
         zxing::Ref<zxing::BinaryBitmap> bitmap(bb);
 
-        Q_ASSERT(m_decoder);
-        if (m_rotate) {            
-            zxing::Ref<zxing::BinaryBitmap> rbitmap = bitmap->rotateCounterClockwise();
-            res = m_decoder->decode(rbitmap, *m_hints);
-        } else {
-            res = m_decoder->decode(bitmap, *m_hints);
+        if (m_multipleCodes) {
+            found=multiBarcode(bitmap);
+            if (!m_formats)
+                return found || noCodeDetected();
         }
 
-#ifdef DEBUG_TIME
-        qDebug() << "SBC+: " << QDateTime::currentMSecsSinceEpoch()-s;
-#endif
+        if (m_race)
+            return raceBarcode(source, bitmap) || found || noCodeDetected();
 
-        QString string = QString(res->getText()->getText().c_str());
-        if (!string.isEmpty() && (string.length() > 0)) {
-            int fmt = res->getBarcodeFormat().value;
+        zxing::Ref<zxing::BinaryBitmap> image = m_rotate ? bitmap->rotateCounterClockwise() : bitmap;
 
-            QString cs = QString::fromStdString(res->getCharSet());
-            if (!cs.isEmpty()) {
-                QTextCodec *codec = QTextCodec::codecForName(res->getCharSet().c_str());
-                if (codec)
-                    string = codec->toUnicode(res->getText()->getText().c_str());
-                m_barcode=cs;
+        Q_ASSERT(m_decoder);
+        res = zxing::Ref<zxing::Result>();
+        if (m_qrTracker && m_qrTracker->isTracking()) {
+            try {
+                res = m_qrTracker->decode(image, *m_hints);
             }
+            catch(zxing::Exception &e) {
+                // Lost track, search the whole frame below
+                Q_UNUSED(e)
+            }
+        }
+        if (!res) {
+            res = m_decoder->decode(image, *m_hints);
+            if (m_qrTracker && res->getBarcodeFormat() == zxing::BarcodeFormat::QR_CODE)
+                m_qrTracker->track(res->getResultPoints());
+        }
 
-#ifdef DEBUG_FILTER
-            qDebug() << fmt << string;
+#ifdef DEBUG_TIME
+        qDebug() << "SBC+: " << QDateTime::currentMSecsSinceEpoch()-s;
 #endif
 
-            emit m_parent->tagFound(string);
-            emit m_parent->tagFoundAdvanced(string, fmt, cs);
-
+        if (emitResult(res))
             return true;
-        }
     }
     catch(zxing::ReaderException &e) {
 #ifdef DEBUG_FILTER
@@ -182,14 +268,274 @@ bool BarcodeVideoFilterRunnable::scanBarcode(VideoFrameWrapper *ciw)
     qDebug() << "SBC-: " << QDateTime::currentMSecsSinceEpoch()-s;
 #endif
 
+    // The QR codes of the multi pass are reported already
+    if (found)
+        return true;
+
     emit m_parent->error(er);
 
     return false;
 }
 
+bool BarcodeVideoFilterRunnable::noCodeDetected()
+{
+    emit m_parent->error(QStringLiteral("No code detected"));
+
+    return false;
+}
+
+bool BarcodeVideoFilterRunnable::emitResult(zxing::Ref<zxing::Result> result, QString *tag)
+{
+    QString string = QString(result->getText()->getText().c_str());
+    if (string.isEmpty())
+        return false;
+
+    int fmt = result->getBarcodeFormat().value;
+
+    QString cs = QString::fromStdString(result->getCharSet());
+    if (!cs.isEmpty()) {
+        QTextCodec *codec = QTextCodec::codecForName(result->getCharSet().c_str());
+        if (codec)
+            string = codec->toUnicode(result->getText()->getText().c_str());
+        m_barcode=cs;
+    }
+
+#ifdef DEBUG_FILTER
+    qDebug() << fmt << string;
+#endif
+
+    emit m_parent->tagFound(string);
+    emit m_parent->tagFoundAdvanced(string, fmt, cs);
+
+    if (tag)
+        *tag=string;
+
+    return true;
+}
+
+// Overlapping finder pattern triples can sample the same code twice, tell
+// them from two codes with the same text by how far apart they are
+static bool isSameCode(zxing::Ref<zxing::Result> a, zxing::Ref<zxing::Result> b)
+{
+    if (a->getText()->getText() != b->getText()->getText())
+        return false;
+
+    QRectF bounds[2];
+    zxing::Ref<zxing::Result> results[2]={a, b};
+    for (int i=0; i<2; i++) {
+        zxing::ArrayRef< zxing::Ref<zxing::ResultPoint> > points=results[i]->getResultPoints();
+        if (points->empty())
+            return true;
+        QPolygonF polygon;
+        for (int j=0; j<points->size(); j++)
+            polygon << QPointF(points[j]->getX(), points[j]->getY());
+        bounds[i]=polygon.boundingRect();
+    }
+
+    // The same code, unless the centres are further apart than its size
+    QPointF d=bounds[0].center()-bounds[1].center();
+    qreal size=qMax(bounds[1].width(), bounds[1].height());
+    return qAbs(d.x()) <= size && qAbs(d.y()) <= size;
+}
+
+/**
+ * Looks for all the QR codes in the frame in one pass, then decodes the
+ * candidates concurrently. Every code found is reported on its own, then
+ * tagsFound() sends the whole list. Nothing is reported when there is no
+ * QR code, the other symbologies are still read by the normal pass.
+ */
+bool BarcodeVideoFilterRunnable::multiBarcode(zxing::Ref<zxing::BinaryBitmap> bitmap)
+{
+    zxing::multi::QRCodeMultiReader reader;
+    std::vector<zxing::Ref<zxing::DetectorResult> > candidates;
+    try {
+        candidates = reader.detectMultiple(bitmap, *m_multiHints);
+    }
+    catch(zxing::Exception &e) {
+#ifdef DEBUG_FILTER
+        qDebug() << "Multi" << e.what();
+#else
+        Q_UNUSED(e)
+#endif
+        return false;
+    }
+
+    QList<QFuture<zxing::Ref<zxing::Result> > > decodes;
+    for (size_t i=0; i<candidates.size(); i++)
+        decodes << QtConcurrent::run(m_multiTp, this, &BarcodeVideoFilterRunnable::decodeCandidate, candidates[i], *m_multiHints);
+
+    QStringList tags;
+    std::vector<zxing::Ref<zxing::Result> > found;
+    for (int i=0; i<decodes.size(); i++) {
+        zxing::Ref<zxing::Result> result=decodes[i].result();
+        if (!result)
+            continue;
+        bool seen=false;
+        for (size_t j=0; j<found.size() && !seen; j++)
+            seen=isSameCode(result, found[j]);
+        if (seen)
+            continue;
+        found.push_back(result);
+
+        QString tag;
+        if (emitResult(result, &tag))
+            tags << tag;
+    }
+
+    if (tags.isEmpty())
+        return false;
+
+    emit m_parent->tagsFound(tags);
+
+    return true;
+}
+
+zxing::Ref<zxing::Result> BarcodeVideoFilterRunnable::decodeCandidate(zxing::Ref<zxing::DetectorResult> candidate, zxing::DecodeHints hints)
+{
+    // Readers keep decoding state, one per thread
+    zxing::multi::QRCodeMultiReader reader;
+    try {
+        return reader.decodeDetected(candidate, hints);
+    }
+    catch(zxing::Exception &e) {
+#ifdef DEBUG_FILTER
+        qDebug() << "Candidate" << e.what();
+#else
+        Q_UNUSED(e)
+#endif
+    }
+
+    return zxing::Ref<zxing::Result>();
+}
+
+/**
+ * Runs the 1D, rotated 1D, QR, DataMatrix, Aztec and PDF417 readers enabled concurrently on the frame.
+ * The first attempt to succeed reports its result and we return as soon as it is done,
+ * attempts that have not started yet are skipped and the ones already running
+ * finish in the background with their results discarded.
+ */
+bool BarcodeVideoFilterRunnable::raceBarcode(zxing::Ref<zxing::LuminanceSource> source, zxing::Ref<zxing::BinaryBitmap> bitmap)
+{
+    QSharedPointer<RaceState> state(new RaceState());
+    int attempts=0;
+
+    if (m_formats & MATRIX_FORMATS) {
+        // The 2D readers only read the black matrix. The bitmap keeps it once built,
+        // so build it here before the attempts share the bitmap.
+        bitmap->getBlackMatrix();
+    }
+    if (m_formats & zxing::DecodeHints::QR_CODE_HINT) {
+        QtConcurrent::run(m_raceTp, this, &BarcodeVideoFilterRunnable::raceAttempt, int(Race_QRCode), bitmap, *m_hints, state);
+        attempts++;
+    }
+    if (m_formats & zxing::DecodeHints::DATA_MATRIX_HINT) {
+        QtConcurrent::run(m_raceTp, this, &BarcodeVideoFilterRunnable::raceAttempt, int(Race_DataMatrix), bitmap, *m_hints, state);
+        attempts++;
+    }
+    if (m_formats & zxing::DecodeHints::AZTEC_HINT) {
+        QtConcurrent::run(m_raceTp, this, &BarcodeVideoFilterRunnable::raceAttempt, int(Race_Aztec), bitmap, *m_hints, state);
+        attempts++;
+    }
+    if (m_formats & zxing::DecodeHints::PDF_417_HINT) {
+        QtConcurrent::run(m_raceTp, this, &BarcodeVideoFilterRunnable::raceAttempt, int(Race_PDF417), bitmap, *m_hints, state);
+        attempts++;
+    }
+    if (m_formats & ONED_FORMATS) {
+        // Binarizers keep per row scratch buffers, so each 1D attempt gets its own.
+        // The black point cache is not thread safe either, leave it to the shared bitmap.
+        zxing::Ref<zxing::BinaryBitmap> normal(new zxing::BinaryBitmap(createBinarizer(source, false)));
+        zxing::Ref<zxing::BinaryBitmap> rotated(new zxing::BinaryBitmap(createBinarizer(source->rotateCounterClockwise(), false)));
+        QtConcurrent::run(m_raceTp, this, &BarcodeVideoFilterRunnable::raceAttempt, int(Race_1D), normal, *m_hints, state);
+        QtConcurrent::run(m_raceTp, this, &BarcodeVideoFilterRunnable::raceAttempt, int(Race_1DRotated), rotated, *m_hints, state);
+        attempts+=2;
+    }
+
+    // The winner releases only after reporting, so the frame is never left while it still emits
+    while (attempts > 0) {
+        state->finished.acquire();
+        attempts--;
+        if (state->reported.load())
+            return true;
+    }
+
+    return false;
+}
+
+void BarcodeVideoFilterRunnable::raceAttempt(int attempt, zxing::Ref<zxing::BinaryBitmap> bitmap, zxing::DecodeHints hints, QSharedPointer<RaceState> state)
+{
+    // Don't bother if a faster attempt already won
+    if (!state->winner.load()) {
+        try {
+            zxing::Ref<zxing::Reader> reader;
+            switch (attempt) {
+            case Race_QRCode:
+                reader=new zxing::qrcode::QRCodeReader();
+                break;
+            case Race_DataMatrix:
+                reader=new zxing::datamatrix::DataMatrixReader();
+                break;
+            case Race_Aztec:
+                reader=new zxing::aztec::AztecReader();
+                break;
+            case Race_PDF417:
+                reader=new zxing::pdf417::PDF417Reader();
+                break;
+            default:
+                reader=new zxing::oned::MultiFormatOneDReader(hints);
+            }
+
+            zxing::Ref<zxing::Result> result = reader->decode(bitmap, hints);
+
+            // Only the winner touches the runnable, raceBarcode() waits until it has reported
+            if (!result->getText()->getText().empty() && state->winner.testAndSetOrdered(0, 1)) {
+                emitResult(result);
+                state->reported.storeRelease(1);
+            }
+        }
+        catch(zxing::Exception &e) {
+#ifdef DEBUG_FILTER
+            qDebug() << "Race" << attempt << e.what();
+#else
+            Q_UNUSED(e)
+#endif
+        }
+    }
+
+    state->finished.release();
+}
+
+zxing::Ref<zxing::Binarizer> BarcodeVideoFilterRunnable::createBinarizer(zxing::Ref<zxing::LuminanceSource> source, bool useCache)
+{
+    switch (m_binarizer) {
+    case Binarizer_AdaptiveThreshold:
+        return zxing::Ref<zxing::Binarizer>(new zxing::AdaptiveThresholdBinarizer(source));
+    case Binarizer_Sauvola:
+        return zxing::Ref<zxing::Binarizer>(new zxing::AdaptiveThresholdBinarizer(source, zxing::AdaptiveThresholdBinarizer::SAUVOLA));
+    case Binarizer_GlobalHistogram:
+        return zxing::Ref<zxing::Binarizer>(new zxing::GlobalHistogramBinarizer(source));
+    case Binarizer_Auto:
+        // Evenly lit frames do fine with the much cheaper global threshold
+        if (zxing::GlobalHistogramBinarizer::hasUniformLighting(source))
+            return zxing::Ref<zxing::Binarizer>(new zxing::GlobalHistogramBinarizer(source));
+        break;
+    case Binarizer_Hybrid:
+    default:;
+    }
+
+    zxing::HybridBinarizer *binz = new zxing::HybridBinarizer(source);
+
+    Q_ASSERT(binz);
+
+    binz->setLocalBlackRows(m_localBlackRows);
+    if (useCache)
+        binz->setBlackPointCache(m_blackPointCache);
+
+    return zxing::Ref<zxing::Binarizer>(binz);
+}
+
 QVideoFilterRunnable *BarcodeVideoFilter::createFilterRunnable()
 {
-    return new BarcodeVideoFilterRunnable(this, m_enabledFormats, m_rotate);
+    return new BarcodeVideoFilterRunnable(this, m_enabledFormats, m_enabledDecoders, m_rotate, m_binarizer, m_reuseBlackPoints, m_race, m_tracking, m_multipleCodes);
 }
 
 void BarcodeVideoFilter::setFormats(BarCodeFormat enabledFormats)
@@ -202,6 +548,26 @@ void BarcodeVideoFilter::setFormats(BarCodeFormat enabledFormats)
     emit enabledFormatsChanged(enabledFormats);
 }
 
+void BarcodeVideoFilter::setDecoders(uint enabledDecoders)
+{
+    if (m_enabledDecoders == enabledDecoders)
+        return;
+
+    m_enabledDecoders = enabledDecoders;
+
+    emit enabledDecodersChanged(enabledDecoders);
+}
+
+void BarcodeVideoFilter::setBinarizer(BarcodeVideoFilter::BinarizerType binarizer)
+{
+    if (m_binarizer == binarizer)
+        return;
+
+    m_binarizer = binarizer;
+
+    emit binarizerChanged(binarizer);
+}
+
 QString BarcodeVideoFilter::formatToString(const int fmt)
 {
     switch (fmt) {
@@ -6,14 +6,19 @@
 #include <QAbstractVideoFilter>
 #include <QFuture>
 #include <QThreadPool>
+#include <QSharedPointer>
+#include <QStringList>
 
 #include <zxing/common/GlobalHistogramBinarizer.h>
 #include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/AdaptiveThresholdBinarizer.h>
 #include <zxing/Binarizer.h>
 #include <zxing/BinaryBitmap.h>
 #include <zxing/MultiFormatReader.h>
 #include <zxing/DecodeHints.h>
+#include <zxing/common/DetectorResult.h>
 #include <zxing/qrcode/ErrorCorrectionLevel.h>
+#include <zxing/qrcode/QRCodeReader.h>
 #include <zxing/zxing/LuminanceSource.h>
 
 #include "VideoFrameWrapper.h"
@@ -23,25 +28,63 @@ class BarcodeVideoFilter;
 class BarcodeVideoFilterRunnable : public QVideoFilterRunnable
 {
 public:
-    explicit BarcodeVideoFilterRunnable(BarcodeVideoFilter *parent, uint filters, bool rotate=false);
+    explicit BarcodeVideoFilterRunnable(BarcodeVideoFilter *parent, uint filters, uint decoders=0, bool rotate=false, uint binarizer=0, bool reuseBlackPoints=false, bool race=false, bool tracking=false, bool multipleCodes=false);
+    ~BarcodeVideoFilterRunnable();
     QVideoFrame run(QVideoFrame *input, const QVideoSurfaceFormat &surfaceFormat, RunFlags flags);
 
     enum FilterBarCodeFormats {
         BarCodeFormat_1D=0x01,
-        BarCodeFormat_2D=0x02
+        BarCodeFormat_2D=0x02,
+        BarCodeFormat_PDF417=0x04
+    };
+
+    enum FilterBinarizer {
+        Binarizer_Hybrid=0,
+        Binarizer_AdaptiveThreshold,
+        Binarizer_GlobalHistogram,
+        Binarizer_Auto,
+        Binarizer_Sauvola
+    };
+
+    enum RaceAttempt {
+        Race_1D=0,
+        Race_1DRotated,
+        Race_QRCode,
+        Race_DataMatrix,
+        Race_Aztec,
+        Race_PDF417
     };
 
 private:
+    struct RaceState;
+
     bool scanBarcode(VideoFrameWrapper *ciw);
+    bool raceBarcode(zxing::Ref<zxing::LuminanceSource> source, zxing::Ref<zxing::BinaryBitmap> bitmap);
+    void raceAttempt(int attempt, zxing::Ref<zxing::BinaryBitmap> bitmap, zxing::DecodeHints hints, QSharedPointer<RaceState> state);
+    bool multiBarcode(zxing::Ref<zxing::BinaryBitmap> bitmap);
+    zxing::Ref<zxing::Result> decodeCandidate(zxing::Ref<zxing::DetectorResult> candidate, zxing::DecodeHints hints);
+    bool emitResult(zxing::Ref<zxing::Result> result, QString *tag=0);
+    bool noCodeDetected();
+    zxing::Ref<zxing::Binarizer> createBinarizer(zxing::Ref<zxing::LuminanceSource> source, bool useCache=true);
     BarcodeVideoFilter *m_parent;
     zxing::MultiFormatReader *m_decoder;
+    zxing::Ref<zxing::qrcode::QRCodeReader> m_qrTracker;
     zxing::DecodeHints *m_hints;
+    zxing::DecodeHints *m_multiHints;
     zxing::Ref<zxing::Result> res;
     QFuture<bool> m_future;
     QString m_barcode;
     bool m_rotate;
+    bool m_race;
+    bool m_multipleCodes;
+    uint m_formats;
+    bool m_localBlackRows;
+    uint m_binarizer;
+    zxing::Ref<zxing::BlackPointCache> m_blackPointCache;
     VideoFrameWrapper *m_fhandler;
     QThreadPool *m_tp;
+    QThreadPool *m_raceTp;
+    QThreadPool *m_multiTp;
 };
 
 class BarcodeVideoFilter : public QAbstractVideoFilter
@@ -49,8 +92,16 @@ class BarcodeVideoFilter : public QAbstractVideoFilter
     Q_OBJECT
     Q_FLAGS(BarCodeFormat)
     Q_ENUMS(BarCodeFormats)
+    Q_ENUMS(DecoderFormat)
+    Q_ENUMS(BinarizerType)
     Q_PROPERTY(BarCodeFormat enabledFormats READ getEnabledFormats WRITE setFormats NOTIFY enabledFormatsChanged)
+    Q_PROPERTY(uint enabledDecoders READ getEnabledDecoders WRITE setDecoders NOTIFY enabledDecodersChanged)
     Q_PROPERTY(bool rotate READ rotate WRITE setRotate NOTIFY rotateChanged)
+    Q_PROPERTY(BinarizerType binarizer READ binarizer WRITE setBinarizer NOTIFY binarizerChanged)
+    Q_PROPERTY(bool reuseBlackPoints READ reuseBlackPoints WRITE setReuseBlackPoints NOTIFY reuseBlackPointsChanged)
+    Q_PROPERTY(bool race READ race WRITE setRace NOTIFY raceChanged)
+    Q_PROPERTY(bool tracking READ tracking WRITE setTracking NOTIFY trackingChanged)
+    Q_PROPERTY(bool multipleCodes READ multipleCodes WRITE setMultipleCodes NOTIFY multipleCodesChanged)
 
 public:
     explicit BarcodeVideoFilter(QAbstractVideoFilter *parent = 0);
@@ -58,10 +109,44 @@ public:
 
     enum BarCodeFormats {
         BarCodeFormat_1D=0x01,
-        BarCodeFormat_2D=0x02
+        BarCodeFormat_2D=0x02,
+        BarCodeFormat_PDF417=0x04
     };
     Q_DECLARE_FLAGS(BarCodeFormat, BarCodeFormats)
 
+    /*
+     * Per symbology selection, same values as QZXing::DecoderFormat.
+     * When any is set it replaces the coarse enabledFormats groups.
+     * There is no MaxiCode reader, so MaxiCode cannot be selected.
+     */
+    enum DecoderFormat {
+        DecoderFormat_None = 0,
+        DecoderFormat_Aztec = 1 << 1,
+        DecoderFormat_CODABAR = 1 << 2,
+        DecoderFormat_CODE_39 = 1 << 3,
+        DecoderFormat_CODE_93 = 1 << 4,
+        DecoderFormat_CODE_128 = 1 << 5,
+        DecoderFormat_DATA_MATRIX = 1 << 6,
+        DecoderFormat_EAN_8 = 1 << 7,
+        DecoderFormat_EAN_13 = 1 << 8,
+        DecoderFormat_ITF = 1 << 9,
+        DecoderFormat_PDF_417 = 1 << 11,
+        DecoderFormat_QR_CODE = 1 << 12,
+        DecoderFormat_RSS_14 = 1 << 13,
+        DecoderFormat_RSS_EXPANDED = 1 << 14,
+        DecoderFormat_UPC_A = 1 << 15,
+        DecoderFormat_UPC_E = 1 << 16,
+        DecoderFormat_UPC_EAN_EXTENSION = 1 << 17
+    };
+
+    enum BinarizerType {
+        Binarizer_Hybrid=0,
+        Binarizer_AdaptiveThreshold,
+        Binarizer_GlobalHistogram,
+        Binarizer_Auto,
+        Binarizer_Sauvola
+    };
+
     Q_INVOKABLE QString formatToString(const int fmt);
 
     uint getEnabledFormats() const
@@ -69,14 +154,48 @@ public:
         return m_enabledFormats;
     }
 
+    uint getEnabledDecoders() const
+    {
+        return m_enabledDecoders;
+    }
+
     bool rotate() const
     {
         return m_rotate;
     }
 
+    BinarizerType binarizer() const
+    {
+        return m_binarizer;
+    }
+
+    bool reuseBlackPoints() const
+    {
+        return m_reuseBlackPoints;
+    }
+
+    bool race() const
+    {
+        return m_race;
+    }
+
+    bool tracking() const
+    {
+        return m_tracking;
+    }
+
+    bool multipleCodes() const
+    {
+        return m_multipleCodes;
+    }
+
 public slots:
     void setFormats(BarcodeVideoFilter::BarCodeFormat enabledFormats);
 
+    void setDecoders(uint enabledDecoders);
+
+    void setBinarizer(BarcodeVideoFilter::BinarizerType binarizer);
+
     void setRotate(bool rotate)
     {
         if (m_rotate == rotate)
@@ -86,23 +205,78 @@ public slots:
         emit rotateChanged(rotate);
     }
 
+    void setReuseBlackPoints(bool reuseBlackPoints)
+    {
+        if (m_reuseBlackPoints == reuseBlackPoints)
+            return;
+
+        m_reuseBlackPoints = reuseBlackPoints;
+        emit reuseBlackPointsChanged(reuseBlackPoints);
+    }
+
+    void setRace(bool race)
+    {
+        if (m_race == race)
+            return;
+
+        m_race = race;
+        emit raceChanged(race);
+    }
+
+    void setTracking(bool tracking)
+    {
+        if (m_tracking == tracking)
+            return;
+
+        m_tracking = tracking;
+        emit trackingChanged(tracking);
+    }
+
+    void setMultipleCodes(bool multipleCodes)
+    {
+        if (m_multipleCodes == multipleCodes)
+            return;
+
+        m_multipleCodes = multipleCodes;
+        emit multipleCodesChanged(multipleCodes);
+    }
+
 signals:
     void finished(QPointF result);
     void decodingStarted();
     void decodingFinished(bool succeeded);
     void tagFound(QString tag);
     void tagFoundAdvanced(QString tag, int format, QString charSet);
+    void tagsFound(QStringList tags);
     void error(QString msg);
 
     void unknownFrameFormat(int format, int width, int height);
 
     void enabledFormatsChanged(uint enabledFormats);
 
+    void enabledDecodersChanged(uint enabledDecoders);
+
     void rotateChanged(bool rotate);
 
+    void binarizerChanged(BarcodeVideoFilter::BinarizerType binarizer);
+
+    void reuseBlackPointsChanged(bool reuseBlackPoints);
+
+    void raceChanged(bool race);
+
+    void trackingChanged(bool tracking);
+
+    void multipleCodesChanged(bool multipleCodes);
+
 private:
     BarCodeFormat m_enabledFormats;
+    uint m_enabledDecoders;
     bool m_rotate;    
+    BinarizerType m_binarizer;
+    bool m_reuseBlackPoints;
+    bool m_race;
+    bool m_tracking;
+    bool m_multipleCodes;
 };
 
 